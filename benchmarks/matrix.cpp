@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+#include <math/solver.hpp>
+#include <utils/generator.hpp>
+#include <random>
+
+namespace {
+    template<typename T>
+    math::Matrix<T> MakeRandomMatrix(size_t rows, size_t columns){
+        std::mt19937 generator{0};
+        std::uniform_real_distribution<double> distribution{-1, 1};
+        math::Matrix<T> matrix(rows, columns);
+        for (size_t i = 0; i < rows; i++)
+            for (size_t j = 0; j < columns; j++)
+                matrix[i][j] = static_cast<T>(distribution(generator));
+        return matrix;
+    }
+
+    template<typename T>
+    void SetBytes(benchmark::State& state, size_t bytes){
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes * sizeof(T)));
+    }
+
+    void SetFlops(benchmark::State& state, double flops){
+        state.counters["FLOPS"] = benchmark::Counter(flops, benchmark::Counter::kIsIterationInvariantRate);
+    }
+}
+
+template<typename T>
+static void BM_Multiply(benchmark::State& state){
+    auto n = static_cast<size_t>(state.range(0));
+    auto left = MakeRandomMatrix<T>(n, n);
+    auto right = MakeRandomMatrix<T>(n, n);
+    for (auto _ : state){
+        auto product = left * right;
+        benchmark::DoNotOptimize(product.Data());
+    }
+    SetFlops(state, 2.0 * n * n * n);
+    SetBytes<T>(state, 3 * n * n);
+}
+BENCHMARK(BM_Multiply<double>)->RangeMultiplier(4)->Range(16, 1024)->UseRealTime();
+BENCHMARK(BM_Multiply<float>)->RangeMultiplier(4)->Range(16, 1024)->UseRealTime();
+
+template<typename T>
+static void BM_Transposition(benchmark::State& state){
+    auto n = static_cast<size_t>(state.range(0));
+    auto matrix = MakeRandomMatrix<T>(n, n);
+    for (auto _ : state){
+        auto transposed = matrix.Transposition();
+        benchmark::DoNotOptimize(transposed.Data());
+    }
+    SetBytes<T>(state, 2 * n * n);
+}
+BENCHMARK(BM_Transposition<double>)->RangeMultiplier(4)->Range(16, 4096)->UseRealTime();
+BENCHMARK(BM_Transposition<float>)->RangeMultiplier(4)->Range(16, 4096)->UseRealTime();
+
+template<typename T>
+static void BM_Normalized(benchmark::State& state){
+    auto n = static_cast<size_t>(state.range(0));
+    math::Vector<T> vector(n);
+    for (size_t i = 0; i < n; i++) vector[i] = static_cast<T>(i % 7) + 1;
+    for (auto _ : state){
+        auto normalized = math::Normalized(vector);
+        benchmark::DoNotOptimize(normalized.Data());
+    }
+    SetFlops(state, 3.0 * n);
+    SetBytes<T>(state, 2 * n);
+}
+BENCHMARK(BM_Normalized<double>)->RangeMultiplier(16)->Range(16, 1 << 20);
+BENCHMARK(BM_Normalized<float>)->RangeMultiplier(16)->Range(16, 1 << 20);
+
+template<size_t kSize>
+static void BM_GenerateAll(benchmark::State& state){
+    constexpr utils::Traits<double> traits{
+            .kMin = -10,
+            .kMax = 10,
+            .kSize = kSize
+    };
+    utils::Generator<double, traits> generator;
+    for (auto _ : state){
+        generator.GenerateAll();
+        benchmark::DoNotOptimize(std::get<3>(generator.GetAll()).Data());
+    }
+    SetBytes<double>(state, 3 * kSize * kSize);
+}
+BENCHMARK(BM_GenerateAll<3>);
+BENCHMARK(BM_GenerateAll<16>);
+BENCHMARK(BM_GenerateAll<64>);
+BENCHMARK(BM_GenerateAll<256>);
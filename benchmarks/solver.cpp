@@ -0,0 +1,48 @@
+#include <benchmark/benchmark.h>
+#include <math/solver.hpp>
+#include <random>
+
+namespace {
+    //symmetric tridiagonal matrix with the diagonal 1/n, 2/n, ..., 1
+    template<typename T>
+    math::Matrix<T> MakeTestMatrix(size_t size){
+        math::Matrix<T> matrix(size);
+        for (size_t i = 0; i < size; i++){
+            matrix[i][i] = static_cast<T>(static_cast<double>(i + 1) / size);
+            if (i > 0) matrix[i][i - 1] = matrix[i - 1][i] = static_cast<T>(0.01);
+        }
+        return matrix;
+    }
+
+    template<typename T, math::Precision kPrecision>
+    constexpr math::Traits<T> kTraits{
+            .kMin = -1,
+            .kMax = 1,
+            .kEpsEigenVector = std::is_same_v<T, float> ? 1e-5 : 1e-10,
+            .kEpsEigenLambda = std::is_same_v<T, float> ? 1e-6 : 1e-12,
+            .kMaxCountIterations = 100000,
+            .kPrecision = kPrecision
+    };
+}
+
+template<typename T, math::Precision kPrecision = math::Precision::Full>
+static void BM_Solve(benchmark::State& state){
+    using Solver = math::Solver<T, kTraits<T, kPrecision>, math::RandomSeed::No, std::uniform_real_distribution<T>>;
+    auto n = static_cast<size_t>(state.range(0));
+    auto matrix = MakeTestMatrix<T>(n);
+    size_t iterations = 0;
+    for (auto _ : state){
+        state.PauseTiming();
+        Solver solver(n, matrix, std::vector<math::EigenPair<T>>{});
+        state.ResumeTiming();
+        solver.Solve();
+        iterations = std::get<4>(solver.GetAll());
+        benchmark::DoNotOptimize(std::get<1>(solver.GetAll()));
+    }
+    state.counters["iterations"] = static_cast<double>(iterations);
+    state.counters["FLOPS"] = benchmark::Counter(2.0 * n * n * iterations, benchmark::Counter::kIsIterationInvariantRate);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * iterations * n * n * sizeof(T)));
+}
+BENCHMARK(BM_Solve<double>)->RangeMultiplier(4)->Range(16, 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Solve<float>)->RangeMultiplier(4)->Range(16, 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Solve<double, math::Precision::Mixed>)->RangeMultiplier(4)->Range(16, 1024)->Unit(benchmark::kMillisecond);
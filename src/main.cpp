@@ -68,11 +68,11 @@ auto FindMaxLambdaIndex(TMatrix&& matrix) {
     return std::make_tuple(max, max2.value());
 }
 
-template<typename TMatrix>
-auto Max(TMatrix&& matrix){
-    auto max = abs(matrix[0][0]);
-    for (size_t i = 1; i < matrix.nRows(); i++){
-        auto value = abs(matrix[i][0]);
+template<typename TVector>
+auto Max(TVector&& vector){
+    auto max = abs(vector[0]);
+    for (size_t i = 1; i < vector.size(); i++){
+        auto value = abs(vector[i]);
         if (max < value) max = value;
     }
     return max;
@@ -100,11 +100,7 @@ auto FindMaxVector(TMatrix&& matrix) {
 
 template<typename TMatrix>
 auto GetVector(TMatrix&& matrix, size_t index){
-    math::Matrix<> result(matrix.nRows(), 1);
-    for (size_t i = 0; i < matrix.nRows(); i++){
-        result[i][0] = matrix[i][index];
-    }
-    return result;
+    return matrix.Column(index);
 }
 
 #define Print(matrix) std::cout << #matrix << '\n'; \
@@ -117,7 +113,8 @@ int main() {
                 .kMax = range,
                 .kSize = 3
         };
-        utils::Generator<double, traits, utils::RandomSeed::Yes> generator;
+        using Generator = utils::Generator<double, traits, utils::RandomSeed::Yes>;
+        Generator generator;
         generator.GenerateAll();
         const auto&[vector, house_m, diag_m, result_m] = generator.GetAll();
         auto[expected_index, expected_2_index] = FindMaxLambdaIndex(diag_m);
@@ -127,12 +124,12 @@ int main() {
         auto[max_vector, max2_vector] = std::make_tuple(expected_index, expected_2_index);
 //        Print(vector);
         Print(house_m);
-        Print(house_m * house_m.Transposition());
+        Print(house_m * house_m.TransposedView());
 //        Print(diag_m);
 //        Print(result_m);
 //        Print(expected_lambda);
 //        Print(GetVector(house_m, max_vector));
-        auto expected_vector = GetVector(house_m, max2_vector);
+        auto expected_vector = Generator::Vector(GetVector(house_m, max2_vector));
         constexpr math::Traits<double> traits2{
                 .kMin = traits.kMin,
                 .kMax = traits.kMax,
@@ -144,18 +141,19 @@ int main() {
         math::Solver<
                 double, traits2,
                 math::RandomSeed::No,
-                std::uniform_real_distribution<>> solver(
+                std::uniform_real_distribution<>,
+                Generator::Matrix> solver(
                 traits.kSize,
                 result_m,
                 expected_lambda,
-                GetVector(house_m, max_vector));
+                math::Vector<>(GetVector(house_m, max_vector)));
         solver.Solve();
         const auto&[counted_previous_lambda_, counted_lambda_, x_, previous_x_, count_iteration] = solver.GetAll();
         Print(previous_x_);
         Print(math::Normalized(previous_x_));
         Print(x_);
-        if (expected_vector[0][0]/x_[0][0] < 0) {
-            expected_vector = expected_vector * -1;
+        if (expected_vector[0]/x_[0] < 0) {
+            expected_vector *= -1;
         }
         Print(expected_vector);
         Print(math::Normalized(x_));
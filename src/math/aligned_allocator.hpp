@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include <limits>
+
+namespace math {
+    inline constexpr size_t kCacheLineSize = 64;
+
+    template<typename T, size_t Alignment = kCacheLineSize>
+    class AlignedAllocator {
+        static_assert(Alignment >= alignof(T), "выравнивание меньше требуемого типом");
+        static_assert((Alignment & (Alignment - 1)) == 0, "выравнивание должно быть степенью двойки");
+    public:
+        using value_type = T;
+        static constexpr size_t kAlignment = Alignment;
+
+        template<typename U>
+        struct rebind {
+            using other = AlignedAllocator<U, Alignment>;
+        };
+
+        AlignedAllocator() noexcept = default;
+        template<typename U>
+        AlignedAllocator(const AlignedAllocator<U, Alignment> &) noexcept {}
+
+        T *allocate(size_t count) {
+            if (count > std::numeric_limits<size_t>::max() / sizeof(T)) {
+                throw std::bad_array_new_length();
+            }
+            return static_cast<T *>(::operator new(count * sizeof(T), std::align_val_t{Alignment}));
+        }
+
+        void deallocate(T *ptr, size_t) noexcept {
+            ::operator delete(ptr, std::align_val_t{Alignment});
+        }
+
+        template<typename U>
+        friend bool operator==(const AlignedAllocator &, const AlignedAllocator<U, Alignment> &) noexcept {
+            return true;
+        }
+    };
+}
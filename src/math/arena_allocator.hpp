@@ -0,0 +1,123 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <vector>
+#include "aligned_allocator.hpp"
+
+namespace math {
+    //bump allocator over a list of chunks: allocation moves a pointer, deallocation is free
+    //except for the most recent block, and Reset hands all the memory back at once.
+    //The chunks are kept, so a workload repeated after Reset does not touch malloc again
+    class Arena {
+        struct Chunk {
+            std::byte *data;
+            size_t size;
+        };
+
+        static constexpr size_t kDefaultChunkSize = size_t{1} << 20;
+        std::vector<Chunk> chunks_;
+        size_t chunk_size_;
+        size_t current_ = 0;
+        size_t offset_ = 0;
+        size_t used_ = 0;
+
+        static size_t AlignUp(size_t value, size_t alignment) {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+    public:
+        explicit Arena(size_t chunk_size = kDefaultChunkSize) : chunk_size_(chunk_size) {}
+
+        Arena(const Arena &) = delete;
+        Arena &operator=(const Arena &) = delete;
+
+        ~Arena() {
+            for (auto &chunk: chunks_)
+                ::operator delete(chunk.data, std::align_val_t{kCacheLineSize});
+        }
+
+        void *Allocate(size_t bytes, size_t alignment = kCacheLineSize) {
+            if (alignment > kCacheLineSize) throw std::bad_alloc();
+            bytes = std::max<size_t>(bytes, 1);
+            while (current_ < chunks_.size()) {
+                auto begin = AlignUp(offset_, alignment);
+                if (begin <= chunks_[current_].size && bytes <= chunks_[current_].size - begin) {
+                    offset_ = begin + bytes;
+                    used_ += bytes;
+                    return chunks_[current_].data + begin;
+                }
+                current_++;
+                offset_ = 0;
+            }
+            auto size = std::max(chunk_size_, AlignUp(bytes, kCacheLineSize));
+            auto data = static_cast<std::byte *>(::operator new(size, std::align_val_t{kCacheLineSize}));
+            chunks_.push_back({data, size});
+            current_ = chunks_.size() - 1;
+            offset_ = bytes;
+            used_ += bytes;
+            return data;
+        }
+
+        //only the last block is really returned, the rest waits for Reset
+        void Deallocate(void *ptr, size_t bytes) noexcept {
+            bytes = std::max<size_t>(bytes, 1);
+            if (current_ < chunks_.size() && static_cast<std::byte *>(ptr) + bytes == chunks_[current_].data + offset_) {
+                offset_ -= bytes;
+                used_ -= bytes;
+            }
+        }
+
+        //every block allocated so far becomes invalid
+        void Reset() noexcept {
+            current_ = 0;
+            offset_ = 0;
+            used_ = 0;
+        }
+
+        //bytes handed out since the last Reset
+        size_t Used() const { return used_; }
+
+        //bytes obtained from the system
+        size_t Capacity() const {
+            size_t capacity = 0;
+            for (auto &chunk: chunks_) capacity += chunk.size;
+            return capacity;
+        }
+    };
+
+    //the arena of the calling thread used by ArenaAllocator
+    inline Arena &ThreadArena() {
+        thread_local Arena arena;
+        return arena;
+    }
+
+    //stateless allocator over ThreadArena: containers using it must not outlive the next
+    //ThreadArena().Reset() and must be created and destroyed on the same thread
+    template<typename T>
+    class ArenaAllocator {
+        static_assert(alignof(T) <= kCacheLineSize, "выравнивание больше строки кэша");
+    public:
+        using value_type = T;
+
+        ArenaAllocator() noexcept = default;
+        template<typename U>
+        ArenaAllocator(const ArenaAllocator<U> &) noexcept {}
+
+        T *allocate(size_t count) {
+            if (count > std::numeric_limits<size_t>::max() / sizeof(T)) {
+                throw std::bad_array_new_length();
+            }
+            return static_cast<T *>(ThreadArena().Allocate(count * sizeof(T)));
+        }
+
+        void deallocate(T *ptr, size_t count) noexcept {
+            ThreadArena().Deallocate(ptr, count * sizeof(T));
+        }
+
+        template<typename U>
+        friend bool operator==(const ArenaAllocator &, const ArenaAllocator<U> &) noexcept {
+            return true;
+        }
+    };
+}
@@ -0,0 +1,191 @@
+#ifndef NUMERIC_METHODS3_MATH_BATCHED_SOLVER
+#define NUMERIC_METHODS3_MATH_BATCHED_SOLVER
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+#include "aligned_allocator.hpp"
+#include "matrix.hpp"
+#include "vector.hpp"
+#include "deflated_operator.hpp"
+#include "parallel.hpp"
+#include "solver.hpp"
+
+namespace math {
+    //the power method of Solver for many small N x N problems at once. Problems are stored
+    //structure of arrays in groups of kLanes: inside a group element (i, j) of its kLanes matrices
+    //is one SIMD-wide run and the runs follow in row-major order, so a mat-vec of a group streams
+    //one contiguous block and every step is a fixed-width loop over the lanes that the compiler
+    //vectorizes. Groups iterate independently until all of their problems converge and are spread over threads
+    template<typename Number,
+            Traits<Number> traits,
+            RandomSeed kRandomSeed,
+            typename Distribution>
+    class BatchedSolver{
+        static constexpr auto kMin = traits.kMin;
+        static constexpr auto kMax = traits.kMax;
+        static constexpr auto kEpsEigenVector = traits.kEpsEigenVector;
+        static constexpr auto kEpsEigenLambda = traits.kEpsEigenLambda;
+        static constexpr auto kMaxCountIterations = traits.kMaxCountIterations;
+        //8 doubles or 16 floats: a run is one cache line and one AVX-512 register
+        static constexpr size_t kLanes = kCacheLineSize / sizeof(Number);
+        using Cells = std::vector<Number, AlignedAllocator<Number>>;
+        size_t N_;
+        size_t count_;
+        size_t groups_;
+        //element (i, j) of problem p = g * kLanes + l is matrices_[((g * N_ + i) * N_ + j) * kLanes + l];
+        //the lanes past count_ hold the identity, so they stay finite
+        Cells matrices_;
+        //component i of problem p = g * kLanes + l is x_[(g * N_ + i) * kLanes + l]
+        Cells x_;
+        Cells previous_x_;
+        Cells v_;
+        Cells next_x_;
+        std::vector<Number> previous_lambdas_;
+        std::vector<Number> lambdas_;
+        std::vector<size_t> count_iterations_;
+
+        Number* Cell(size_t group, size_t i, size_t j){
+            return matrices_.data() + ((group * N_ + i) * N_ + j) * kLanes;
+        }
+        Number* Component(Cells& cells, size_t group, size_t i){
+            return cells.data() + (group * N_ + i) * kLanes;
+        }
+        //power steps for the problems of group, every loop runs over all kLanes lanes
+        void SolveLanes(size_t group){
+            auto begin = group * kLanes;
+            auto width = std::min(kLanes, count_ - begin);
+            bool active[kLanes] = {};
+            std::fill(active, active + width, true);
+            size_t active_count = width;
+            while (active_count > 0){
+                alignas(kCacheLineSize) Number norms[kLanes] = {};
+                alignas(kCacheLineSize) Number lambdas[kLanes] = {};
+                alignas(kCacheLineSize) Number eps_vectors[kLanes] = {};
+                for (size_t i = 0; i < N_; i++){
+                    auto x = Component(x_, group, i);
+                    for (size_t p = 0; p < kLanes; p++) norms[p] += x[p] * x[p];
+                }
+                for (size_t p = 0; p < kLanes; p++) norms[p] = 1 / std::sqrt(norms[p]);
+                for (size_t i = 0; i < N_; i++){
+                    auto x = Component(x_, group, i);
+                    auto v = Component(v_, group, i);
+                    for (size_t p = 0; p < kLanes; p++) v[p] = x[p] * norms[p];
+                }
+                for (size_t i = 0; i < N_; i++){
+                    auto next = Component(next_x_, group, i);
+                    std::fill(next, next + kLanes, Number{});
+                    for (size_t j = 0; j < N_; j++){
+                        auto a = Cell(group, i, j);
+                        auto v = Component(v_, group, j);
+                        for (size_t p = 0; p < kLanes; p++) next[p] += a[p] * v[p];
+                    }
+                    auto v = Component(v_, group, i);
+                    auto x = Component(x_, group, i);
+                    for (size_t p = 0; p < kLanes; p++){
+                        lambdas[p] += v[p] * next[p];
+                        eps_vectors[p] = std::max(eps_vectors[p], std::abs(next[p] - x[p]));
+                    }
+                }
+                for (size_t i = 0; i < N_; i++){
+                    auto x = Component(x_, group, i);
+                    auto previous = Component(previous_x_, group, i);
+                    auto next = Component(next_x_, group, i);
+                    for (size_t p = 0; p < width; p++){
+                        if (!active[p]) continue;
+                        previous[p] = x[p];
+                        x[p] = next[p];
+                    }
+                }
+                for (size_t p = 0; p < width; p++){
+                    if (!active[p]) continue;
+                    auto problem = begin + p;
+                    previous_lambdas_[problem] = lambdas_[problem];
+                    lambdas_[problem] = lambdas[p];
+                    count_iterations_[problem]++;
+                    auto eps_lambda = std::abs(previous_lambdas_[problem] - lambdas_[problem]);
+                    if (eps_vectors[p] <= kEpsEigenVector || eps_lambda <= kEpsEigenLambda ||
+                        count_iterations_[problem] >= kMaxCountIterations){
+                        active[p] = false;
+                        active_count--;
+                    }
+                }
+            }
+        }
+    public:
+        void Solve(){
+            ParallelRows(groups_, N_ * N_ * kLanes * 16, [&](size_t group_begin, size_t group_end){
+                for (size_t group = group_begin; group < group_end; group++){
+                    SolveLanes(group);
+                }
+            });
+        }
+        size_t Count() const{
+            return count_;
+        }
+        //x of the problem, the same vector Solver returns as x_
+        Vector<Number> GetVector(size_t problem) const{
+            if (problem >= count_) throw std::invalid_argument("loh");
+            Vector<Number> result(N_);
+            auto group = problem / kLanes;
+            for (size_t i = 0; i < N_; i++) result[i] = x_[(group * N_ + i) * kLanes + problem % kLanes];
+            return result;
+        }
+        //previous_lambdas_, lambdas_, count_iterations_, one entry per problem
+        decltype(auto) GetAll(){
+            return std::tie(previous_lambdas_, lambdas_, count_iterations_);
+        }
+        //found is either empty or holds the pair to deflate for every matrix;
+        //like separate Solver instances, every problem starts from the same random vector
+        BatchedSolver(size_t N,
+                      const std::vector<Matrix<Number>>& matrices,
+                      const std::vector<EigenPair<Number>>& found = {}) :
+                N_(N),
+                count_(matrices.size()),
+                groups_((count_ + kLanes - 1) / kLanes),
+                matrices_(groups_ * N * N * kLanes),
+                x_(groups_ * N * kLanes),
+                previous_x_(groups_ * N * kLanes),
+                v_(groups_ * N * kLanes),
+                next_x_(groups_ * N * kLanes),
+                previous_lambdas_(count_),
+                lambdas_(count_),
+                count_iterations_(count_)
+        {
+            static_assert(kMin < kMax, "минимум должен быть меньше максимума");
+            if (!found.empty() && found.size() != count_) throw std::invalid_argument("loh");
+            for (size_t p = count_; p < groups_ * kLanes; p++){
+                for (size_t i = 0; i < N_; i++)
+                    Cell(p / kLanes, i, i)[p % kLanes] = 1;
+            }
+            for (size_t p = 0; p < count_; p++){
+                auto& matrix = matrices[p];
+                auto group = p / kLanes;
+                auto lane = p % kLanes;
+                if (matrix.nRows() != N_ || matrix.nColumns() != N_) throw std::invalid_argument("loh");
+                for (size_t i = 0; i < N_; i++)
+                    for (size_t j = 0; j < N_; j++)
+                        Cell(group, i, j)[lane] = matrix[i][j];
+                if (found.empty()) continue;
+                //small problems are deflated explicitly: A - lambda * v * v^T
+                auto& [lambda, vector] = found[p];
+                if (vector.size() != N_) throw std::invalid_argument("loh");
+                for (size_t i = 0; i < N_; i++)
+                    for (size_t j = 0; j < N_; j++)
+                        Cell(group, i, j)[lane] -= lambda * vector[i] * vector[j];
+                lambdas_[p] = lambda;
+            }
+            Distribution distribution_{kMin, kMax};
+            std::mt19937 number_generator_{kRandomSeed == RandomSeed::Yes ? std::random_device{}() : 0};
+            for (size_t i = 0; i < N_; i++){
+                auto value = distribution_(number_generator_);
+                for (size_t group = 0; group < groups_; group++){
+                    std::fill(Component(x_, group, i), Component(x_, group, i) + kLanes, value);
+                }
+            }
+        }
+    };
+}
+#endif
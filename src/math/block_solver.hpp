@@ -0,0 +1,197 @@
+#ifndef NUMERIC_METHODS3_MATH_BLOCK_SOLVER
+#define NUMERIC_METHODS3_MATH_BLOCK_SOLVER
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "matrix.hpp"
+#include "vector.hpp"
+#include "symmetric_eigen.hpp"
+#include "solver.hpp"
+
+namespace math {
+    //subspace iteration for the count eigenpairs of a symmetric matrix with the largest |lambda|.
+    //The block is kept as count x N rows, so A * X is one blocked product per iteration;
+    //every orthonormalization_interval steps the block is orthonormalized and a Rayleigh-Ritz
+    //step on X^T A X gives the current eigenpairs
+    template<typename Number,
+            Traits<Number> traits,
+            RandomSeed kRandomSeed,
+            typename Distribution>
+    class BlockSolver{
+        static constexpr auto kMin = traits.kMin;
+        static constexpr auto kMax = traits.kMax;
+        static constexpr auto kEpsEigenVector = traits.kEpsEigenVector;
+        static constexpr auto kEpsEigenLambda = traits.kEpsEigenLambda;
+        static constexpr auto kMaxCountIterations = traits.kMaxCountIterations;
+        size_t N_;
+        size_t count_;
+        size_t orthonormalization_interval_;
+        Matrix<Number> A;
+        //rows are the vectors of the block
+        Matrix<Number> x_;
+        Matrix<Number> ax_;
+        //count x N target of the Ritz rotation, swapped with x_ and ax_
+        Matrix<Number> rotated_;
+        //X^T A X, its eigenvectors in the columns of ritz_ and the same columns sorted in sorted_
+        Matrix<Number> projected_;
+        Matrix<Number> ritz_;
+        Matrix<Number> sorted_;
+        std::vector<size_t> order_;
+        Vector<Number> lambdas_;
+        Vector<Number> previous_lambdas_;
+        bool has_lambdas_ = false;
+        size_t count_iteration = 0;
+
+        static void Zero(Matrix<Number>& matrix){
+            for (size_t i = 0; i < matrix.nRows(); i++){
+                std::fill(matrix.RowData(i), matrix.RowData(i) + matrix.nColumns(), Number{});
+            }
+        }
+        void Multiply(){
+            Zero(ax_);
+            MultiplyTo<Number>(x_.View(), A.TransposedView(), ax_.View());
+            count_iteration++;
+        }
+        void NormalizeRows(Matrix<Number>& block){
+            for (size_t i = 0; i < count_; i++){
+                auto row = block.RowData(i);
+                auto norm = std::sqrt(Dot(N_, row, row));
+                if (norm == 0) continue;
+                for (size_t j = 0; j < N_; j++) row[j] /= norm;
+            }
+        }
+        //modified Gram-Schmidt applied twice keeps the rows orthonormal to working precision
+        void Orthonormalize(Matrix<Number>& block){
+            for (size_t pass = 0; pass < 2; pass++){
+                for (size_t i = 0; i < count_; i++){
+                    auto row = block.RowData(i);
+                    for (size_t k = 0; k < i; k++){
+                        auto basis = block.RowData(k);
+                        auto projection = Dot(N_, basis, row);
+                        for (size_t j = 0; j < N_; j++) row[j] -= projection * basis[j];
+                    }
+                    auto norm = std::sqrt(Dot(N_, row, row));
+                    if (norm == 0) continue;
+                    for (size_t j = 0; j < N_; j++) row[j] /= norm;
+                }
+            }
+        }
+        //block = sorted_^T * block through rotated_
+        void Rotate(Matrix<Number>& block){
+            Zero(rotated_);
+            MultiplyTo<Number>(sorted_.TransposedView(), block.View(), rotated_.View());
+            std::swap(block, rotated_);
+        }
+        //x_ is orthonormal here; rotates x_ and ax_ to the Ritz vectors and returns the largest residual.
+        //Works only on the buffers allocated in the constructor
+        double RayleighRitz(){
+            Zero(projected_);
+            MultiplyTo<Number>(x_.View(), ax_.TransposedView(), projected_.View());
+            for (size_t i = 0; i < count_; i++)
+                for (size_t j = 0; j < i; j++)
+                    projected_[i][j] = projected_[j][i] = (projected_[i][j] + projected_[j][i]) / 2;
+            Zero(ritz_);
+            for (size_t i = 0; i < count_; i++) ritz_[i][i] = 1;
+            JacobiEigen(projected_.View(), ritz_.View());
+            std::iota(order_.begin(), order_.end(), 0);
+            std::sort(order_.begin(), order_.end(), [&](size_t left, size_t right){
+                return std::abs(projected_[left][left]) > std::abs(projected_[right][right]);
+            });
+            swap(previous_lambdas_, lambdas_);
+            for (size_t i = 0; i < count_; i++){
+                lambdas_[i] = projected_[order_[i]][order_[i]];
+                for (size_t k = 0; k < count_; k++)
+                    sorted_[k][i] = ritz_[k][order_[i]];
+            }
+            Rotate(x_);
+            Rotate(ax_);
+            double max_residual = 0;
+            for (size_t i = 0; i < count_; i++){
+                double residual = 0;
+                for (size_t j = 0; j < N_; j++){
+                    auto diff = ax_[i][j] - lambdas_[i] * x_[i][j];
+                    residual += diff * diff;
+                }
+                max_residual = std::max(max_residual, std::sqrt(residual));
+            }
+            return max_residual;
+        }
+        double CountEpsLambda(){
+            if (!has_lambdas_){
+                has_lambdas_ = true;
+                return std::numeric_limits<double>::infinity();
+            }
+            double max = 0;
+            for (size_t i = 0; i < count_; i++)
+                max = std::max<double>(max, std::abs(previous_lambdas_[i] - lambdas_[i]));
+            return max;
+        }
+    public:
+        //the step that reaches kMaxCountIterations always starts from an orthonormalized block,
+        //so even an unconverged run returns Ritz pairs of an orthonormal basis
+        void Solve(){
+            bool orthonormal = true;
+            size_t since_orthonormalization = 0;
+            while (count_iteration < kMaxCountIterations){
+                Multiply();
+                if (orthonormal){
+                    auto cur_eps_vector = RayleighRitz();
+                    auto cur_eps_eigen_lambda = CountEpsLambda();
+                    if (cur_eps_vector <= kEpsEigenVector || cur_eps_eigen_lambda <= kEpsEigenLambda ||
+                        count_iteration >= kMaxCountIterations){
+                        break;
+                    }
+                }
+                std::swap(x_, ax_);
+                if (++since_orthonormalization >= orthonormalization_interval_ ||
+                    count_iteration + 1 >= kMaxCountIterations){
+                    Orthonormalize(x_);
+                    orthonormal = true;
+                    since_orthonormalization = 0;
+                } else {
+                    NormalizeRows(x_);
+                    orthonormal = false;
+                }
+            }
+        }
+        //lambdas sorted by decreasing |lambda|, eigenvectors as rows in the same order, count_iteration
+        decltype(auto) GetAll(){
+            return std::tie(lambdas_, x_, count_iteration);
+        }
+        BlockSolver(size_t N,
+                    Matrix<Number> matrix,
+                    size_t count,
+                    size_t orthonormalization_interval = 1) :
+                N_(N),
+                count_(count),
+                orthonormalization_interval_(std::max<size_t>(orthonormalization_interval, 1)),
+                A(std::move(matrix)),
+                x_(count, N),
+                ax_(count, N),
+                rotated_(count, N),
+                projected_(count, count),
+                ritz_(count, count),
+                sorted_(count, count),
+                order_(count),
+                lambdas_(count),
+                previous_lambdas_(count)
+        {
+            static_assert(kMin < kMax, "минимум должен быть меньше максимума");
+            if (count_ == 0 || count_ > N_ || A.nRows() != N_ || A.nColumns() != N_)
+                throw std::invalid_argument("loh");
+            Distribution distribution_{kMin, kMax};
+            std::mt19937 number_generator_{kRandomSeed == RandomSeed::Yes ? std::random_device{}() : 0};
+            for (size_t i = 0; i < count_; i++)
+                for (size_t j = 0; j < N_; j++)
+                    x_[i][j] = distribution_(number_generator_);
+            Orthonormalize(x_);
+        }
+    };
+}
+#endif
@@ -0,0 +1,44 @@
+#pragma once
+#include <atomic>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MATH_HAS_X86_SIMD 1
+#else
+#define MATH_HAS_X86_SIMD 0
+#endif
+
+namespace math {
+    enum struct SimdLevel{
+        Scalar, Avx2, Avx512
+    };
+
+    inline SimdLevel DetectSimdLevel(){
+#if MATH_HAS_X86_SIMD
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")){
+            return SimdLevel::Avx512;
+        }
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")){
+            return SimdLevel::Avx2;
+        }
+#endif
+        return SimdLevel::Scalar;
+    }
+
+    namespace detail {
+        inline std::atomic<SimdLevel>& SimdLevelStorage(){
+            static std::atomic<SimdLevel> level{DetectSimdLevel()};
+            return level;
+        }
+    }
+
+    inline SimdLevel CurrentSimdLevel(){
+        return detail::SimdLevelStorage().load(std::memory_order_relaxed);
+    }
+
+    //lowers the instruction set used by the kernels; a level above the detected one is ignored
+    inline void LimitSimdLevel(SimdLevel level){
+        auto detected = DetectSimdLevel();
+        detail::SimdLevelStorage().store(level < detected ? level : detected, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "vector.hpp"
+#include "linear_operator.hpp"
+#include "expression.hpp"
+
+namespace math {
+    template<typename T = double>
+    struct EigenPair {
+        T lambda;
+        Vector<T> vector;
+    };
+
+    //(M - sum lambda_k v_k v_k^T) applied as M x - sum lambda_k v_k (v_k^T x):
+    //the deflated matrix is never formed and any number of found pairs can be removed
+    template<typename Operator, typename T = double>
+    requires IsLinearOperator<Operator, T>
+    class DeflatedOperator {
+        Operator operator_;
+        std::vector<EigenPair<T>> pairs_;
+    public:
+        explicit DeflatedOperator(Operator op, std::vector<EigenPair<T>> pairs = {}) :
+                operator_(std::move(op)) {
+            for (auto &pair: pairs) {
+                Deflate(std::move(pair));
+            }
+        }
+
+        size_t nRows() const {
+            return operator_.nRows();
+        }
+
+        //the vector is expected to be normalized
+        void Deflate(EigenPair<T> pair) {
+            if (pair.vector.size() != nRows()) throw std::invalid_argument("loh");
+            pairs_.push_back(std::move(pair));
+        }
+
+        const Operator &GetOperator() const {
+            return operator_;
+        }
+
+        const std::vector<EigenPair<T>> &GetPairs() const {
+            return pairs_;
+        }
+
+        //x and y are Vector or FixedVector, whichever the operator takes
+        template<typename VectorType>
+        friend T GemvDot(const DeflatedOperator &op, const VectorType &x, VectorType &y) {
+            auto dot = GemvDot(op.operator_, x, y);
+            for (auto &[lambda, vector]: op.pairs_) {
+                auto projection = Dot(x.size(), vector.Data(), x.Data());
+                auto scale = lambda * projection;
+                for (size_t i = 0; i < y.size(); i++)
+                    y[i] -= scale * vector[i];
+                dot -= scale * projection;
+            }
+            return dot;
+        }
+    };
+
+    //dense M - sum lambda_k v_k v_k^T for the methods that need the matrix itself, like LU
+    template<typename Operator, typename T>
+    Matrix<T> Materialize(const DeflatedOperator<Operator, T> &op) {
+        Matrix<T> result(op.GetOperator());
+        for (auto &[lambda, vector]: op.GetPairs()) {
+            result = result - lambda * Outer(vector, vector);
+        }
+        return result;
+    }
+}
@@ -0,0 +1,184 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "matrix_expression.hpp"
+#include "matrix.hpp"
+#include "vector.hpp"
+
+//Expressions keep references to the matrices and vectors they are built from,
+//so they must be evaluated (assigned to a Matrix) while those operands are alive
+
+namespace math {
+    template<typename Info, typename Allocator = AlignedAllocator<Info>>
+    class MatrixReference : public MatrixExpression<MatrixReference<Info, Allocator>> {
+        const Matrix<Info, Allocator> &matrix_;
+    public:
+        using value_type = Info;
+
+        explicit MatrixReference(const Matrix<Info, Allocator> &matrix) : matrix_(matrix) {}
+
+        size_t nRows() const { return matrix_.nRows(); }
+        size_t nColumns() const { return matrix_.nColumns(); }
+        Info operator()(size_t i, size_t j) const { return matrix_.RowData(i)[j]; }
+        bool Reads(const void *begin, const void *end) const { return matrix_.View().Reads(begin, end); }
+    };
+
+    template<typename Info = double>
+    class Identity : public MatrixExpression<Identity<Info>> {
+        size_t size_;
+    public:
+        using value_type = Info;
+
+        explicit Identity(size_t size) : size_(size) {}
+
+        size_t nRows() const { return size_; }
+        size_t nColumns() const { return size_; }
+        Info operator()(size_t i, size_t j) const { return i == j ? Info{1} : Info{}; }
+        bool Reads(const void *, const void *) const { return false; }
+    };
+
+    template<typename Scalar, typename Expression>
+    class ScaledExpression : public MatrixExpression<ScaledExpression<Scalar, Expression>> {
+        Scalar scalar_;
+        Expression expression_;
+    public:
+        using value_type = decltype(std::declval<Scalar>() * std::declval<typename Expression::value_type>());
+
+        ScaledExpression(Scalar scalar, Expression expression) : scalar_(scalar), expression_(std::move(expression)) {}
+
+        size_t nRows() const { return expression_.nRows(); }
+        size_t nColumns() const { return expression_.nColumns(); }
+        value_type operator()(size_t i, size_t j) const { return scalar_ * expression_(i, j); }
+        bool Reads(const void *begin, const void *end) const { return expression_.Reads(begin, end); }
+    };
+
+    template<typename Left, typename Right, typename Operation>
+    class ElementwiseExpression : public MatrixExpression<ElementwiseExpression<Left, Right, Operation>> {
+        Left left_;
+        Right right_;
+    public:
+        using value_type = decltype(Operation{}(std::declval<typename Left::value_type>(),
+                                                std::declval<typename Right::value_type>()));
+
+        ElementwiseExpression(Left left, Right right) : left_(std::move(left)), right_(std::move(right)) {
+            if (left_.nRows() != right_.nRows() || left_.nColumns() != right_.nColumns())
+                throw std::invalid_argument("loh");
+        }
+
+        size_t nRows() const { return left_.nRows(); }
+        size_t nColumns() const { return left_.nColumns(); }
+        value_type operator()(size_t i, size_t j) const { return Operation{}(left_(i, j), right_(i, j)); }
+
+        bool Reads(const void *begin, const void *end) const {
+            return left_.Reads(begin, end) || right_.Reads(begin, end);
+        }
+    };
+
+    template<typename Expression>
+    class TransposedExpression : public MatrixExpression<TransposedExpression<Expression>> {
+        Expression expression_;
+    public:
+        using value_type = typename Expression::value_type;
+
+        explicit TransposedExpression(Expression expression) : expression_(std::move(expression)) {}
+
+        size_t nRows() const { return expression_.nColumns(); }
+        size_t nColumns() const { return expression_.nRows(); }
+        value_type operator()(size_t i, size_t j) const { return expression_(j, i); }
+        bool Reads(const void *begin, const void *end) const { return expression_.Reads(begin, end); }
+    };
+
+    //left * right^T for two column vectors
+    template<typename LCell, typename RCell>
+    class OuterProduct : public MatrixExpression<OuterProduct<LCell, RCell>> {
+        StridedSpan<const LCell> left_;
+        StridedSpan<const RCell> right_;
+    public:
+        using value_type = decltype(std::declval<LCell>() * std::declval<RCell>());
+
+        OuterProduct(StridedSpan<const LCell> left, StridedSpan<const RCell> right) : left_(left), right_(right) {}
+
+        size_t nRows() const { return left_.size(); }
+        size_t nColumns() const { return right_.size(); }
+        value_type operator()(size_t i, size_t j) const { return left_[i] * right_[j]; }
+
+        bool Reads(const void *begin, const void *end) const {
+            return MatrixView<const LCell>(left_.Data(), left_.size(), 1, left_.Step()).Reads(begin, end) ||
+                   MatrixView<const RCell>(right_.Data(), 1, right_.size(), 0, right_.Step()).Reads(begin, end);
+        }
+    };
+
+    template<typename T>
+    struct IsMatrixType : std::false_type {};
+
+    template<typename Info, typename Allocator>
+    struct IsMatrixType<Matrix<Info, Allocator>> : std::true_type {};
+
+    template<typename T>
+    concept IsExpressionOperand = IsMatrixExpression<T> || IsMatrixType<std::remove_cvref_t<T>>::value;
+
+    template<typename Info, typename Allocator>
+    auto Lazy(const Matrix<Info, Allocator> &matrix) {
+        return MatrixReference<Info, Allocator>(matrix);
+    }
+
+    template<typename Expression>
+    requires IsMatrixExpression<Expression>
+    auto Lazy(const Expression &expression) {
+        return expression;
+    }
+
+    template<typename LCell, typename RCell>
+    auto Outer(StridedSpan<LCell> left, StridedSpan<RCell> right) {
+        return OuterProduct<std::remove_const_t<LCell>, std::remove_const_t<RCell>>(left, right);
+    }
+
+    template<typename LCell, typename RCell>
+    auto Outer(const Vector<LCell> &left, const Vector<RCell> &right) {
+        return Outer(left.View(), right.View());
+    }
+
+    template<typename Expression>
+    requires IsExpressionOperand<Expression>
+    auto Transposed(const Expression &expression) {
+        return TransposedExpression<decltype(Lazy(expression))>(Lazy(expression));
+    }
+
+    //at least one operand must be an expression, Matrix op Matrix keeps the eager operators
+    template<typename Left, typename Right>
+    requires IsExpressionOperand<Left> && IsExpressionOperand<Right> &&
+             (IsMatrixExpression<Left> || IsMatrixExpression<Right>)
+    auto operator+(const Left &left, const Right &right) {
+        using Result = ElementwiseExpression<decltype(Lazy(left)), decltype(Lazy(right)), std::plus<>>;
+        return Result(Lazy(left), Lazy(right));
+    }
+
+    template<typename Left, typename Right>
+    requires IsExpressionOperand<Left> && IsExpressionOperand<Right> &&
+             (IsMatrixExpression<Left> || IsMatrixExpression<Right>)
+    auto operator-(const Left &left, const Right &right) {
+        using Result = ElementwiseExpression<decltype(Lazy(left)), decltype(Lazy(right)), std::minus<>>;
+        return Result(Lazy(left), Lazy(right));
+    }
+
+    template<IsScalar Scalar, typename Expression>
+    requires IsMatrixExpression<Expression>
+    auto operator*(const Scalar &scalar, const Expression &expression) {
+        return ScaledExpression<Scalar, Expression>(scalar, expression);
+    }
+
+    template<typename Expression, IsScalar Scalar>
+    requires IsMatrixExpression<Expression>
+    auto operator*(const Expression &expression, const Scalar &scalar) {
+        return ScaledExpression<Scalar, Expression>(scalar, expression);
+    }
+
+    template<typename Expression>
+    requires IsMatrixExpression<Expression>
+    auto operator-(const Expression &expression) {
+        return ScaledExpression<typename Expression::value_type, Expression>(-1, expression);
+    }
+}
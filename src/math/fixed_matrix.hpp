@@ -0,0 +1,341 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <initializer_list>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+#include "matrix_expression.hpp"
+#include "strided_span.hpp"
+#include "view.hpp"
+#include "matrix.hpp"
+#include "vector.hpp"
+#include "linear_operator.hpp"
+
+namespace math {
+    //largest R * C kept on the stack by MatrixFor; 16 x 16 doubles are 2 KiB
+    inline constexpr size_t kMaxFixedCells = 256;
+
+    //R x C matrix with the sizes in the type: the cells live inside the object and every
+    //kernel loops over compile-time bounds, so small products unroll into straight-line code
+    template<typename Info, size_t R, size_t C>
+    class FixedMatrix : public MatrixExpression<FixedMatrix<Info, R, C>> {
+        std::array<Info, R * C> m_cells{};
+    public:
+        using value_type = Info;
+        using RowSpan = StridedSpan<Info>;
+        using ConstRowSpan = StridedSpan<const Info>;
+
+        constexpr FixedMatrix() = default;
+
+        constexpr FixedMatrix(std::initializer_list<std::initializer_list<Info>> list) {
+            if (list.size() != R) throw std::invalid_argument("loh");
+            size_t i = 0;
+            for (auto &row: list) {
+                if (row.size() != C) throw std::invalid_argument("loh");
+                size_t j = 0;
+                for (auto &elem: row) (*this)(i, j++) = elem;
+                i++;
+            }
+        }
+
+        //evaluates an expression of the same size, e.g. a Householder reflection
+        template<typename Expression>
+        requires std::is_convertible_v<typename Expression::value_type, Info>
+        constexpr FixedMatrix(const MatrixExpression<Expression> &expression) {
+            auto &self = expression.Self();
+            if (self.nRows() != R || self.nColumns() != C) throw std::invalid_argument("loh");
+            for (size_t i = 0; i < R; i++)
+                for (size_t j = 0; j < C; j++)
+                    (*this)(i, j) = self(i, j);
+        }
+
+        static constexpr size_t nRows() { return R; }
+        static constexpr size_t nColumns() { return C; }
+        bool Reads(const void *begin, const void *end) const { return View().Reads(begin, end); }
+
+        constexpr Info *Data() { return m_cells.data(); }
+        constexpr const Info *Data() const { return m_cells.data(); }
+        constexpr Info *RowData(size_t i) { return m_cells.data() + i * C; }
+        constexpr const Info *RowData(size_t i) const { return m_cells.data() + i * C; }
+
+        constexpr Info &operator()(size_t i, size_t j) { return m_cells[i * C + j]; }
+        constexpr const Info &operator()(size_t i, size_t j) const { return m_cells[i * C + j]; }
+
+        RowSpan operator[](size_t i) { return RowSpan(RowData(i), C); }
+        ConstRowSpan operator[](size_t i) const { return ConstRowSpan(RowData(i), C); }
+
+        MatrixView<Info> View() { return MatrixView<Info>(Data(), R, C, C); }
+        MatrixView<const Info> View() const { return MatrixView<const Info>(Data(), R, C, C); }
+        MatrixView<const Info> TransposedView() const { return View().Transposed(); }
+        ConstRowSpan Row(size_t i) const { return View().Row(i); }
+        ConstRowSpan Column(size_t j) const { return View().Column(j); }
+
+        constexpr FixedMatrix<Info, C, R> Transposition() const {
+            FixedMatrix<Info, C, R> result;
+#pragma GCC unroll 16
+            for (size_t i = 0; i < R; i++)
+#pragma GCC unroll 16
+                for (size_t j = 0; j < C; j++)
+                    result(j, i) = (*this)(i, j);
+            return result;
+        }
+
+        constexpr friend bool operator==(const FixedMatrix &left, const FixedMatrix &right) {
+            return left.m_cells == right.m_cells;
+        }
+
+        constexpr friend FixedMatrix operator+(const FixedMatrix &left, const FixedMatrix &right) {
+            FixedMatrix result;
+#pragma GCC unroll 16
+            for (size_t k = 0; k < R * C; k++)
+                result.m_cells[k] = left.m_cells[k] + right.m_cells[k];
+            return result;
+        }
+
+        constexpr friend FixedMatrix operator-(const FixedMatrix &left, const FixedMatrix &right) {
+            FixedMatrix result;
+#pragma GCC unroll 16
+            for (size_t k = 0; k < R * C; k++)
+                result.m_cells[k] = left.m_cells[k] - right.m_cells[k];
+            return result;
+        }
+
+        //any arithmetic scalar, so 2 * matrix stays a FixedMatrix instead of a lazy expression
+        template<IsScalar Scalar>
+        constexpr friend FixedMatrix operator*(const Scalar &scalar, const FixedMatrix &matrix) {
+            FixedMatrix result;
+#pragma GCC unroll 16
+            for (size_t k = 0; k < R * C; k++)
+                result.m_cells[k] = static_cast<Info>(scalar) * matrix.m_cells[k];
+            return result;
+        }
+
+        template<IsScalar Scalar>
+        constexpr friend FixedMatrix operator*(const FixedMatrix &matrix, const Scalar &scalar) {
+            return scalar * matrix;
+        }
+    };
+
+    //i-k-j with all three bounds known, small sizes are unrolled completely
+    template<typename Info, size_t R, size_t K, size_t C>
+    constexpr FixedMatrix<Info, R, C> operator*(const FixedMatrix<Info, R, K> &left, const FixedMatrix<Info, K, C> &right) {
+        FixedMatrix<Info, R, C> result;
+#pragma GCC unroll 16
+        for (size_t i = 0; i < R; i++)
+#pragma GCC unroll 16
+            for (size_t k = 0; k < K; k++) {
+                auto value = left(i, k);
+#pragma GCC unroll 16
+                for (size_t j = 0; j < C; j++)
+                    result(i, j) += value * right(k, j);
+            }
+        return result;
+    }
+
+    template<typename Info, size_t R, size_t C>
+    constexpr std::array<Info, R> operator*(const FixedMatrix<Info, R, C> &matrix, const std::array<Info, C> &vector) {
+        std::array<Info, R> result{};
+#pragma GCC unroll 16
+        for (size_t i = 0; i < R; i++)
+#pragma GCC unroll 16
+            for (size_t j = 0; j < C; j++)
+                result[i] += matrix(i, j) * vector[j];
+        return result;
+    }
+
+    template<typename Info, size_t R, size_t C, typename RCell>
+    requires std::is_same_v<Info, std::remove_const_t<RCell>>
+    auto operator*(const FixedMatrix<Info, R, C> &left, const MatrixView<RCell> &right) {
+        return left.View() * right;
+    }
+
+    template<typename Info, size_t N>
+    constexpr FixedMatrix<Info, N, N> MakeFixedIdentityMatrix() {
+        FixedMatrix<Info, N, N> matrix;
+        for (size_t i = 0; i < N; i++)
+            matrix(i, i) = 1;
+        return matrix;
+    }
+
+    //y = A x, returns (x, y); makes FixedMatrix a linear operator for Solver
+    template<typename T, size_t R, size_t C>
+    T GemvDot(const FixedMatrix<T, R, C> &matrix, const Vector<T> &x, Vector<T> &y) {
+        if (x.size() != C || y.size() != R) throw std::invalid_argument("loh");
+        T dot{};
+#pragma GCC unroll 16
+        for (size_t i = 0; i < R; i++) {
+            T sum{};
+#pragma GCC unroll 16
+            for (size_t j = 0; j < C; j++)
+                sum += matrix(i, j) * x[j];
+            y[i] = sum;
+            if (i < C) dot += x[i] * sum;
+        }
+        return dot;
+    }
+
+    template<typename T, size_t R, size_t C>
+    Vector<T> operator*(const FixedMatrix<T, R, C> &matrix, const Vector<T> &vector) {
+        Vector<T> result(R);
+        GemvDot(matrix, vector, result);
+        return result;
+    }
+
+    //N-vector with the size in the type, the work vector of Solver for a FixedMatrix:
+    //it has the interface of Vector, so the code written for Vector(size) runs on it unchanged
+    template<typename Info, size_t N>
+    class FixedVector {
+        std::array<Info, N> m_cells{};
+    public:
+        using value_type = Info;
+
+        constexpr FixedVector() = default;
+
+        constexpr explicit FixedVector(size_t size) {
+            if (size != N) throw std::invalid_argument("loh");
+        }
+
+        constexpr FixedVector(std::initializer_list<Info> list) {
+            if (list.size() != N) throw std::invalid_argument("loh");
+            size_t i = 0;
+            for (auto &elem: list) m_cells[i++] = elem;
+        }
+
+        explicit FixedVector(const StridedSpan<const Info> &span) {
+            if (span.size() != N) throw std::invalid_argument("loh");
+            for (size_t i = 0; i < N; i++) m_cells[i] = span[i];
+        }
+
+        static constexpr size_t size() { return N; }
+
+        constexpr Info *Data() { return m_cells.data(); }
+        constexpr const Info *Data() const { return m_cells.data(); }
+
+        StridedSpan<Info> View() { return StridedSpan<Info>(Data(), N); }
+        StridedSpan<const Info> View() const { return StridedSpan<const Info>(Data(), N); }
+
+        constexpr Info &operator[](size_t i) { return m_cells[i]; }
+        constexpr const Info &operator[](size_t i) const { return m_cells[i]; }
+
+        constexpr auto begin() { return m_cells.begin(); }
+        constexpr auto end() { return m_cells.end(); }
+        constexpr auto begin() const { return m_cells.begin(); }
+        constexpr auto end() const { return m_cells.end(); }
+
+        constexpr friend void swap(FixedVector &left, FixedVector &right) noexcept {
+            left.m_cells.swap(right.m_cells);
+        }
+
+        constexpr friend bool operator==(const FixedVector &left, const FixedVector &right) {
+            return left.m_cells == right.m_cells;
+        }
+
+        constexpr friend FixedVector operator+(const FixedVector &left, const FixedVector &right) {
+            FixedVector result;
+#pragma GCC unroll 16
+            for (size_t i = 0; i < N; i++)
+                result.m_cells[i] = left.m_cells[i] + right.m_cells[i];
+            return result;
+        }
+
+        constexpr friend FixedVector operator-(const FixedVector &left, const FixedVector &right) {
+            FixedVector result;
+#pragma GCC unroll 16
+            for (size_t i = 0; i < N; i++)
+                result.m_cells[i] = left.m_cells[i] - right.m_cells[i];
+            return result;
+        }
+
+        template<IsScalar Scalar>
+        constexpr friend FixedVector operator*(const Scalar &scalar, const FixedVector &vector) {
+            FixedVector result;
+#pragma GCC unroll 16
+            for (size_t i = 0; i < N; i++)
+                result.m_cells[i] = static_cast<Info>(scalar) * vector.m_cells[i];
+            return result;
+        }
+
+        template<IsScalar Scalar>
+        constexpr friend FixedVector operator*(const FixedVector &vector, const Scalar &scalar) {
+            return scalar * vector;
+        }
+
+        template<IsScalar Scalar>
+        constexpr friend FixedVector operator/(const FixedVector &vector, const Scalar &scalar) {
+            FixedVector result;
+#pragma GCC unroll 16
+            for (size_t i = 0; i < N; i++)
+                result.m_cells[i] = vector.m_cells[i] / static_cast<Info>(scalar);
+            return result;
+        }
+
+        template<IsScalar Scalar>
+        constexpr friend FixedVector &operator*=(FixedVector &vector, const Scalar &scalar) {
+#pragma GCC unroll 16
+            for (size_t i = 0; i < N; i++)
+                vector.m_cells[i] *= static_cast<Info>(scalar);
+            return vector;
+        }
+
+        friend std::ostream &operator<<(std::ostream &out, const FixedVector &vector) {
+            for (auto &elem: vector.m_cells)
+                out << elem << "\t\n";
+            return out;
+        }
+    };
+
+    template<typename T, size_t N>
+    constexpr T Dot(const FixedVector<T, N> &left, const FixedVector<T, N> &right) {
+        T sum{};
+#pragma GCC unroll 16
+        for (size_t i = 0; i < N; i++)
+            sum += left[i] * right[i];
+        return sum;
+    }
+
+    //result = vector / |vector| when |vector|^2 is already known; result may be vector
+    template<typename T, size_t N>
+    void NormalizeTo(const FixedVector<T, N> &vector, FixedVector<T, N> &result, T squared_norm) {
+        auto norm = std::sqrt(squared_norm);
+#pragma GCC unroll 16
+        for (size_t i = 0; i < N; i++)
+            result[i] = vector[i] / norm;
+    }
+
+    template<typename T, size_t N>
+    void NormalizeTo(const FixedVector<T, N> &vector, FixedVector<T, N> &result) {
+        NormalizeTo(vector, result, Dot(vector, vector));
+    }
+
+    template<typename T, size_t R, size_t C>
+    T GemvDot(const FixedMatrix<T, R, C> &matrix, const FixedVector<T, C> &x, FixedVector<T, R> &y) {
+        T dot{};
+#pragma GCC unroll 16
+        for (size_t i = 0; i < R; i++) {
+            T sum{};
+#pragma GCC unroll 16
+            for (size_t j = 0; j < C; j++)
+                sum += matrix(i, j) * x[j];
+            y[i] = sum;
+            if (i < C) dot += x[i] * sum;
+        }
+        return dot;
+    }
+
+    //Solver iterates on a FixedMatrix without touching the heap
+    template<typename Info, size_t R, size_t C, typename T>
+    struct OperatorVector<FixedMatrix<Info, R, C>, T> {
+        using type = FixedVector<T, R>;
+    };
+
+    //the matrix type for sizes known at compile time: small ones are FixedMatrix, the rest Matrix.
+    //Allocator only applies to the Matrix branch, a FixedMatrix never touches the heap
+    template<typename Info, size_t R, size_t C, typename Allocator = AlignedAllocator<Info>>
+    using MatrixFor = std::conditional_t<R * C <= kMaxFixedCells, FixedMatrix<Info, R, C>, Matrix<Info, Allocator>>;
+
+    //the vector type next to MatrixFor<Info, N, N, Allocator>
+    template<typename Info, size_t N, typename Allocator = AlignedAllocator<Info>>
+    using VectorFor = std::conditional_t<N * N <= kMaxFixedCells, FixedVector<Info, N>, Vector<Info, Allocator>>;
+}
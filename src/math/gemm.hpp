@@ -0,0 +1,150 @@
+#pragma once
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+#include "simd.hpp"
+
+namespace math {
+    namespace detail {
+        //blocks are chosen so that a kGemmBlockK x kGemmBlockN panel of B stays in L2
+        //and a kGemmBlockM x kGemmBlockK panel of A stays in L1
+        inline constexpr size_t kGemmBlockM = 64;
+        inline constexpr size_t kGemmBlockN = 256;
+        inline constexpr size_t kGemmBlockK = 128;
+        inline constexpr size_t kGemmMicroRows = 4;
+
+        template<typename T>
+        void GemmScalarTile(size_t rows, size_t cols, size_t depth,
+                            const T *a, size_t lda, const T *b, size_t ldb, T *c, size_t ldc) {
+            for (size_t i = 0; i < rows; i++) {
+                auto c_row = c + i * ldc;
+                for (size_t p = 0; p < depth; p++) {
+                    auto a_value = a[i * lda + p];
+                    auto b_row = b + p * ldb;
+                    for (size_t j = 0; j < cols; j++) {
+                        c_row[j] += a_value * b_row[j];
+                    }
+                }
+            }
+        }
+
+        template<typename T>
+        void GemmScalar(size_t m, size_t n, size_t k,
+                        const T *a, size_t lda, const T *b, size_t ldb, T *c, size_t ldc) {
+            for (size_t jc = 0; jc < n; jc += kGemmBlockN) {
+                auto nb = std::min(kGemmBlockN, n - jc);
+                for (size_t pc = 0; pc < k; pc += kGemmBlockK) {
+                    auto kb = std::min(kGemmBlockK, k - pc);
+                    for (size_t ic = 0; ic < m; ic += kGemmBlockM) {
+                        auto mb = std::min(kGemmBlockM, m - ic);
+                        GemmScalarTile(mb, nb, kb, a + ic * lda + pc, lda, b + pc * ldb + jc, ldb,
+                                       c + ic * ldc + jc, ldc);
+                    }
+                }
+            }
+        }
+
+#if MATH_HAS_X86_SIMD
+        //register block: Rows x (2 * Width) elements of C are kept in registers for the whole depth
+        template<typename T, size_t Width, size_t Rows>
+        [[gnu::always_inline]] inline void GemmMicroKernel(size_t depth,
+                                                           const T *a, size_t lda, const T *b, size_t ldb,
+                                                           T *c, size_t ldc) {
+            using V = typename SimdVector<T, Width>::type;
+            V acc[Rows][2];
+            for (size_t r = 0; r < Rows; r++) {
+                SimdLoad(acc[r][0], c + r * ldc);
+                SimdLoad(acc[r][1], c + r * ldc + Width);
+            }
+            for (size_t p = 0; p < depth; p++) {
+                V b0, b1;
+                SimdLoad(b0, b + p * ldb);
+                SimdLoad(b1, b + p * ldb + Width);
+                for (size_t r = 0; r < Rows; r++) {
+                    V a_value = a[r * lda + p] - V{};
+                    acc[r][0] = acc[r][0] + a_value * b0;
+                    acc[r][1] = acc[r][1] + a_value * b1;
+                }
+            }
+            for (size_t r = 0; r < Rows; r++) {
+                SimdStore(c + r * ldc, acc[r][0]);
+                SimdStore(c + r * ldc + Width, acc[r][1]);
+            }
+        }
+
+        template<typename T, size_t Width>
+        [[gnu::always_inline]] inline void GemmSimdTile(size_t rows, size_t cols, size_t depth,
+                                                        const T *a, size_t lda, const T *b, size_t ldb,
+                                                        T *c, size_t ldc) {
+            constexpr size_t kCols = 2 * Width;
+            auto full_cols = cols / kCols * kCols;
+            size_t i = 0;
+            for (; i + kGemmMicroRows <= rows; i += kGemmMicroRows) {
+                for (size_t j = 0; j < full_cols; j += kCols) {
+                    GemmMicroKernel<T, Width, kGemmMicroRows>(depth, a + i * lda, lda, b + j, ldb, c + i * ldc + j, ldc);
+                }
+            }
+            for (; i < rows; i++) {
+                for (size_t j = 0; j < full_cols; j += kCols) {
+                    GemmMicroKernel<T, Width, 1>(depth, a + i * lda, lda, b + j, ldb, c + i * ldc + j, ldc);
+                }
+            }
+            if (full_cols != cols) {
+                GemmScalarTile(rows, cols - full_cols, depth, a, lda, b + full_cols, ldb, c + full_cols, ldc);
+            }
+        }
+
+        template<typename T, size_t Width>
+        [[gnu::always_inline]] inline void GemmSimd(size_t m, size_t n, size_t k,
+                                                    const T *a, size_t lda, const T *b, size_t ldb,
+                                                    T *c, size_t ldc) {
+            for (size_t jc = 0; jc < n; jc += kGemmBlockN) {
+                auto nb = std::min(kGemmBlockN, n - jc);
+                for (size_t pc = 0; pc < k; pc += kGemmBlockK) {
+                    auto kb = std::min(kGemmBlockK, k - pc);
+                    for (size_t ic = 0; ic < m; ic += kGemmBlockM) {
+                        auto mb = std::min(kGemmBlockM, m - ic);
+                        GemmSimdTile<T, Width>(mb, nb, kb, a + ic * lda + pc, lda, b + pc * ldb + jc, ldb,
+                                               c + ic * ldc + jc, ldc);
+                    }
+                }
+            }
+        }
+
+        template<typename T>
+        [[gnu::target("avx2,fma")]] inline void GemmAvx2(size_t m, size_t n, size_t k,
+                                                         const T *a, size_t lda, const T *b, size_t ldb,
+                                                         T *c, size_t ldc) {
+            GemmSimd<T, 32 / sizeof(T)>(m, n, k, a, lda, b, ldb, c, ldc);
+        }
+
+        template<typename T>
+        [[gnu::target("avx512f")]] inline void GemmAvx512(size_t m, size_t n, size_t k,
+                                                          const T *a, size_t lda, const T *b, size_t ldb,
+                                                          T *c, size_t ldc) {
+            GemmSimd<T, 64 / sizeof(T)>(m, n, k, a, lda, b, ldb, c, ldc);
+        }
+#endif
+    }
+
+    //C[m x n] += A[m x k] * B[k x n]; all operands are row-major with leading dimensions lda, ldb, ldc
+    template<typename T>
+    void Gemm(size_t m, size_t n, size_t k,
+              const T *a, size_t lda, const T *b, size_t ldb, T *c, size_t ldc) {
+#if MATH_HAS_X86_SIMD
+        if constexpr (IsSimdReal<T>) {
+            switch (CurrentSimdLevel()) {
+                case SimdLevel::Avx512:
+                    detail::GemmAvx512(m, n, k, a, lda, b, ldb, c, ldc);
+                    return;
+                case SimdLevel::Avx2:
+                    detail::GemmAvx2(m, n, k, a, lda, b, ldb, c, ldc);
+                    return;
+                case SimdLevel::Scalar:
+                    break;
+            }
+        }
+#endif
+        detail::GemmScalar(m, n, k, a, lda, b, ldb, c, ldc);
+    }
+}
@@ -0,0 +1,157 @@
+#pragma once
+#include <cstddef>
+#include <algorithm>
+#include "simd.hpp"
+
+namespace math {
+    namespace detail {
+        inline constexpr size_t kGemvMicroRows = 4;
+
+        template<typename T>
+        T DotScalar(size_t n, const T *x, const T *y) {
+            T sum{};
+            for (size_t i = 0; i < n; i++) {
+                sum += x[i] * y[i];
+            }
+            return sum;
+        }
+
+        template<typename T>
+        T GemvDotScalar(size_t m, size_t n, const T *a, size_t lda, const T *x, T *y) {
+            T dot{};
+            for (size_t i = 0; i < m; i++) {
+                y[i] = DotScalar(n, a + i * lda, x);
+                if (i < n) dot += x[i] * y[i];
+            }
+            return dot;
+        }
+
+#if MATH_HAS_X86_SIMD
+        template<typename T, size_t Width>
+        [[gnu::always_inline]] inline T DotSimd(size_t n, const T *x, const T *y) {
+            using V = typename SimdVector<T, Width>::type;
+            V acc0{}, acc1{};
+            size_t i = 0;
+            for (; i + 2 * Width <= n; i += 2 * Width) {
+                V x0, x1, y0, y1;
+                SimdLoad(x0, x + i);
+                SimdLoad(x1, x + i + Width);
+                SimdLoad(y0, y + i);
+                SimdLoad(y1, y + i + Width);
+                acc0 = acc0 + x0 * y0;
+                acc1 = acc1 + x1 * y1;
+            }
+            acc0 = acc0 + acc1;
+            auto sum = SimdSum<T>(acc0);
+            for (; i < n; i++) {
+                sum += x[i] * y[i];
+            }
+            return sum;
+        }
+
+        //Rows rows of A share every load of x
+        template<typename T, size_t Width, size_t Rows>
+        [[gnu::always_inline]] inline void GemvMicroKernel(size_t n, const T *a, size_t lda, const T *x, T *y) {
+            using V = typename SimdVector<T, Width>::type;
+            V acc[Rows] = {};
+            auto full = n / Width * Width;
+            for (size_t j = 0; j < full; j += Width) {
+                V x_value;
+                SimdLoad(x_value, x + j);
+                for (size_t r = 0; r < Rows; r++) {
+                    V a_value;
+                    SimdLoad(a_value, a + r * lda + j);
+                    acc[r] = acc[r] + a_value * x_value;
+                }
+            }
+            for (size_t r = 0; r < Rows; r++) {
+                auto sum = SimdSum<T>(acc[r]);
+                for (size_t j = full; j < n; j++) {
+                    sum += a[r * lda + j] * x[j];
+                }
+                y[r] = sum;
+            }
+        }
+
+        template<typename T, size_t Width>
+        [[gnu::always_inline]] inline T GemvDotSimd(size_t m, size_t n, const T *a, size_t lda, const T *x, T *y) {
+            T dot{};
+            size_t i = 0;
+            for (; i + kGemvMicroRows <= m; i += kGemvMicroRows) {
+                GemvMicroKernel<T, Width, kGemvMicroRows>(n, a + i * lda, lda, x, y + i);
+                for (size_t r = i; r < std::min(i + kGemvMicroRows, n); r++) {
+                    dot += x[r] * y[r];
+                }
+            }
+            for (; i < m; i++) {
+                GemvMicroKernel<T, Width, 1>(n, a + i * lda, lda, x, y + i);
+                if (i < n) dot += x[i] * y[i];
+            }
+            return dot;
+        }
+
+        template<typename T>
+        [[gnu::target("avx2,fma")]] inline T DotAvx2(size_t n, const T *x, const T *y) {
+            return DotSimd<T, 32 / sizeof(T)>(n, x, y);
+        }
+
+        template<typename T>
+        [[gnu::target("avx512f")]] inline T DotAvx512(size_t n, const T *x, const T *y) {
+            return DotSimd<T, 64 / sizeof(T)>(n, x, y);
+        }
+
+        template<typename T>
+        [[gnu::target("avx2,fma")]] inline T GemvDotAvx2(size_t m, size_t n, const T *a, size_t lda,
+                                                        const T *x, T *y) {
+            return GemvDotSimd<T, 32 / sizeof(T)>(m, n, a, lda, x, y);
+        }
+
+        template<typename T>
+        [[gnu::target("avx512f")]] inline T GemvDotAvx512(size_t m, size_t n, const T *a, size_t lda,
+                                                         const T *x, T *y) {
+            return GemvDotSimd<T, 64 / sizeof(T)>(m, n, a, lda, x, y);
+        }
+#endif
+    }
+
+    template<typename T>
+    T Dot(size_t n, const T *x, const T *y) {
+#if MATH_HAS_X86_SIMD
+        if constexpr (IsSimdReal<T>) {
+            switch (CurrentSimdLevel()) {
+                case SimdLevel::Avx512:
+                    return detail::DotAvx512(n, x, y);
+                case SimdLevel::Avx2:
+                    return detail::DotAvx2(n, x, y);
+                case SimdLevel::Scalar:
+                    break;
+            }
+        }
+#endif
+        return detail::DotScalar(n, x, y);
+    }
+
+    //y[m] = A[m x n] * x[n] in one pass over A; returns (x, y) over the first min(m, n) elements,
+    //which for a square A and a normalized x is the Rayleigh quotient
+    template<typename T>
+    T GemvDot(size_t m, size_t n, const T *a, size_t lda, const T *x, T *y) {
+#if MATH_HAS_X86_SIMD
+        if constexpr (IsSimdReal<T>) {
+            switch (CurrentSimdLevel()) {
+                case SimdLevel::Avx512:
+                    return detail::GemvDotAvx512(m, n, a, lda, x, y);
+                case SimdLevel::Avx2:
+                    return detail::GemvDotAvx2(m, n, a, lda, x, y);
+                case SimdLevel::Scalar:
+                    break;
+            }
+        }
+#endif
+        return detail::GemvDotScalar(m, n, a, lda, x, y);
+    }
+
+    template<typename T>
+    void Gemv(size_t m, size_t n, const T *a, size_t lda, const T *x, T *y) {
+        GemvDot(m, n, a, lda, x, y);
+    }
+}
@@ -0,0 +1,108 @@
+#pragma once
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include "matrix_expression.hpp"
+#include "vector.hpp"
+
+namespace math {
+    //H = E - 2 * v * v^T for a unit vector v; H x costs O(n) and H is materialized in O(n^2).
+    //Cells is the vector type that stores v
+    template<typename Info = double, typename Cells = Vector<Info>>
+    class HouseholderReflection : public MatrixExpression<HouseholderReflection<Info, Cells>> {
+        Cells vector_;
+    public:
+        using value_type = Info;
+
+        HouseholderReflection() = default;
+        explicit HouseholderReflection(Cells unit_vector) : vector_(std::move(unit_vector)) {}
+
+        size_t nRows() const { return vector_.size(); }
+        size_t nColumns() const { return vector_.size(); }
+        bool Reads(const void *, const void *) const { return false; }
+
+        Info operator()(size_t i, size_t j) const {
+            return (i == j ? Info{1} : Info{}) - 2 * vector_[i] * vector_[j];
+        }
+
+        const Cells &GetVector() const {
+            return vector_;
+        }
+
+        //y = H * x; y may be the same vector as x
+        void Apply(const StridedSpan<const Info> &x, const StridedSpan<Info> &y) const {
+            if (x.size() != nRows() || y.size() != nRows()) throw std::invalid_argument("loh");
+            auto projection = 2 * Dot(vector_.View(), x);
+            for (size_t i = 0; i < nRows(); i++)
+                y[i] = x[i] - projection * vector_[i];
+        }
+    };
+
+    template<typename Info = double, typename Cells = Vector<Info>>
+    class DiagonalMatrix : public MatrixExpression<DiagonalMatrix<Info, Cells>> {
+        Cells diagonal_;
+    public:
+        using value_type = Info;
+
+        DiagonalMatrix() = default;
+        explicit DiagonalMatrix(Cells diagonal) : diagonal_(std::move(diagonal)) {}
+
+        size_t nRows() const { return diagonal_.size(); }
+        size_t nColumns() const { return diagonal_.size(); }
+        bool Reads(const void *, const void *) const { return false; }
+
+        Info operator()(size_t i, size_t j) const {
+            return i == j ? diagonal_[i] : Info{};
+        }
+
+        const Cells &GetDiagonal() const {
+            return diagonal_;
+        }
+    };
+
+    //H * D * H^T for a Householder reflection H and a diagonal D without forming H:
+    //with w = D v and alpha = v^T D v the element is d_i [i == j] - 2 v_i w_j - 2 w_i v_j + 4 alpha v_i v_j
+    template<typename Info = double, typename Cells = Vector<Info>>
+    class ReflectedDiagonal : public MatrixExpression<ReflectedDiagonal<Info, Cells>> {
+        Cells vector_;
+        Cells diagonal_;
+        Cells weighted_;
+        Info alpha_{};
+    public:
+        using value_type = Info;
+
+        ReflectedDiagonal() = default;
+        ReflectedDiagonal(const HouseholderReflection<Info, Cells> &reflection,
+                          const DiagonalMatrix<Info, Cells> &diagonal) :
+                vector_(reflection.GetVector()),
+                diagonal_(diagonal.GetDiagonal()),
+                weighted_(vector_.size()) {
+            if (vector_.size() != diagonal_.size()) throw std::invalid_argument("loh");
+            for (size_t i = 0; i < vector_.size(); i++) {
+                weighted_[i] = diagonal_[i] * vector_[i];
+            }
+            alpha_ = Dot(vector_, weighted_);
+        }
+
+        size_t nRows() const { return vector_.size(); }
+        size_t nColumns() const { return vector_.size(); }
+        bool Reads(const void *, const void *) const { return false; }
+
+        Info operator()(size_t i, size_t j) const {
+            auto value = -2 * (vector_[i] * weighted_[j] + weighted_[i] * vector_[j]) +
+                         4 * alpha_ * vector_[i] * vector_[j];
+            return i == j ? value + diagonal_[i] : value;
+        }
+
+        //y = H * D * H^T * x in O(n); y may be the same vector as x
+        void Apply(const StridedSpan<const Info> &x, const StridedSpan<Info> &y) const {
+            if (x.size() != nRows() || y.size() != nRows()) throw std::invalid_argument("loh");
+            auto projection = 2 * Dot(vector_.View(), x);
+            for (size_t i = 0; i < nRows(); i++)
+                y[i] = diagonal_[i] * (x[i] - projection * vector_[i]);
+            projection = 2 * Dot(vector_.View(), StridedSpan<const Info>(y));
+            for (size_t i = 0; i < nRows(); i++)
+                y[i] -= projection * vector_[i];
+        }
+    };
+}
@@ -0,0 +1,246 @@
+#ifndef NUMERIC_METHODS3_MATH_LANCZOS_SOLVER
+#define NUMERIC_METHODS3_MATH_LANCZOS_SOLVER
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+#include "matrix.hpp"
+#include "vector.hpp"
+#include "deflated_operator.hpp"
+#include "symmetric_eigen.hpp"
+#include "solver.hpp"
+
+namespace math {
+    //Lanczos iteration for the eigenpair with the largest |lambda| of a symmetric matrix.
+    //The basis q_0..q_j spans the Krylov space of the start vector, A restricted to it is the
+    //tridiagonal T_j, and the Ritz pair of T_j converges in far fewer mat-vecs than the power method.
+    //Orthogonality is kept selectively (Parlett-Scott): the new q is only orthogonalized against
+    //the Ritz vectors that already converged, since those are the directions it loses orthogonality to.
+    //After max_basis steps the iteration restarts from the current Ritz vector
+    template<typename Number,
+            Traits<Number> traits,
+            RandomSeed kRandomSeed,
+            typename Distribution,
+            typename Operator = Matrix<Number>>
+    requires IsLinearOperator<Operator, Number>
+    class LanczosSolver{
+        static constexpr auto kMin = traits.kMin;
+        static constexpr auto kMax = traits.kMax;
+        static constexpr auto kEpsEigenVector = traits.kEpsEigenVector;
+        static constexpr auto kEpsEigenLambda = traits.kEpsEigenLambda;
+        static constexpr auto kMaxCountIterations = traits.kMaxCountIterations;
+        static constexpr size_t kDefaultBasis = 64;
+        size_t N_;
+        size_t max_basis_;
+        DeflatedOperator<Operator, Number> A;
+        Number previous_lambda_ = 0;
+        Number lambda_ = 0;
+        Vector<Number> x_;
+        Vector<Number> previous_x_;
+        //rows are q_0..q_j
+        Matrix<Number> basis_;
+        Vector<Number> q_;
+        Vector<Number> w_;
+        std::vector<Number> alphas_;
+        std::vector<Number> betas_;
+        //converged Ritz vectors for the selective reorthogonalization
+        std::vector<Vector<Number>> locked_;
+        //workspace of the tridiagonal eigensolver, allocated once for max_basis
+        Vector<Number> diagonal_;
+        Vector<Number> off_diagonal_;
+        //last components of the eigenvectors of T_j
+        Vector<Number> bottom_;
+        //eigenvectors of T_j, computed only when a Ritz vector is needed
+        Matrix<Number> ritz_vectors_;
+        size_t count_iteration = 0;
+
+        //w_ = A q_j - alpha_j q_j - beta_{j-1} q_{j-1}, then q_{j+1} = w_ / beta_j; returns beta_j
+        Number OneStep(size_t j){
+            auto current = basis_.RowData(j);
+            for (size_t index = 0; index < N_; index++){
+                q_[index] = current[index];
+            }
+            auto alpha = GemvDot(A, q_, w_);
+            count_iteration++;
+            for (size_t index = 0; index < N_; index++){
+                w_[index] -= alpha * current[index];
+            }
+            if (j > 0){
+                auto previous = basis_.RowData(j - 1);
+                auto beta = betas_[j - 1];
+                for (size_t index = 0; index < N_; index++){
+                    w_[index] -= beta * previous[index];
+                }
+            }
+            for (auto& vector : locked_){
+                auto projection = Dot(vector, w_);
+                for (size_t index = 0; index < N_; index++){
+                    w_[index] -= projection * vector[index];
+                }
+            }
+            alphas_.push_back(alpha);
+            auto beta = std::sqrt(Dot(w_, w_));
+            betas_.push_back(beta);
+            if (j + 1 < max_basis_ && beta != 0){
+                auto next = basis_.RowData(j + 1);
+                for (size_t index = 0; index < N_; index++){
+                    next[index] = w_[index] / beta;
+                }
+            }
+            return beta;
+        }
+        void RitzVector(const MatrixView<const Number>& vectors, size_t column, size_t size, Vector<Number>& result){
+            for (size_t index = 0; index < N_; index++){
+                result[index] = 0;
+            }
+            for (size_t k = 0; k < size; k++){
+                auto scale = vectors(k, column);
+                auto row = basis_.RowData(k);
+                for (size_t index = 0; index < N_; index++){
+                    result[index] += scale * row[index];
+                }
+            }
+        }
+        //eigenvalues of T_j into diagonal_ and, with full, its eigenvectors into ritz_vectors_;
+        //otherwise only their last components into bottom_, which is all the residuals need
+        void SolveTridiagonal(size_t size, bool full){
+            for (size_t i = 0; i < size; i++){
+                diagonal_[i] = alphas_[i];
+                off_diagonal_[i] = i + 1 < size ? betas_[i] : 0;
+            }
+            if (full){
+                MatrixView<Number> vectors(ritz_vectors_.Data(), size, size, ritz_vectors_.Stride());
+                for (size_t i = 0; i < size; i++){
+                    for (size_t k = 0; k < size; k++){
+                        vectors(i, k) = i == k ? 1 : 0;
+                    }
+                }
+                TridiagonalEigen(diagonal_.Data(), off_diagonal_.Data(), size, vectors);
+            } else {
+                for (size_t i = 0; i < size; i++){
+                    bottom_[i] = i + 1 == size ? 1 : 0;
+                }
+                TridiagonalEigen(diagonal_.Data(), off_diagonal_.Data(), size,
+                                 MatrixView<Number>(bottom_.Data(), 1, size, size));
+            }
+        }
+        size_t Dominant(size_t size) const{
+            size_t dominant = 0;
+            for (size_t i = 1; i < size; i++){
+                if (std::abs(diagonal_[i]) > std::abs(diagonal_[dominant])) dominant = i;
+            }
+            return dominant;
+        }
+        MatrixView<const Number> RitzVectors(size_t size) const{
+            return MatrixView<const Number>(ritz_vectors_.Data(), size, size, ritz_vectors_.Stride());
+        }
+        //x_ = the dominant Ritz vector of T_j, previous_x_ keeps the last one computed
+        void UpdateRitzVector(size_t size){
+            SolveTridiagonal(size, true);
+            swap(previous_x_, x_);
+            RitzVector(RitzVectors(size), Dominant(size), size, x_);
+        }
+        //Ritz values of T_j in O(j^2) without allocating; updates lambda_, locks the newly
+        //converged Ritz vectors and returns the residual estimate beta_j * |s_j| of the dominant pair
+        Number RayleighRitz(size_t size){
+            SolveTridiagonal(size, false);
+            auto dominant = Dominant(size);
+            auto beta = betas_[size - 1];
+            previous_lambda_ = lambda_;
+            lambda_ = diagonal_[dominant];
+            auto residual = beta * std::abs(bottom_[dominant]);
+            auto threshold = std::sqrt(std::numeric_limits<Number>::epsilon()) * std::abs(lambda_);
+            size_t converged = 0;
+            for (size_t i = 0; i < size; i++){
+                if (beta * std::abs(bottom_[i]) <= threshold) converged++;
+            }
+            if (converged > locked_.size()){
+                //the full solve makes the same rotations, so bottom_ still matches its columns
+                SolveTridiagonal(size, true);
+                locked_.clear();
+                for (size_t i = 0; i < size; i++){
+                    if (beta * std::abs(bottom_[i]) > threshold) continue;
+                    locked_.emplace_back(N_);
+                    RitzVector(RitzVectors(size), i, size, locked_.back());
+                }
+            }
+            return residual;
+        }
+        void Restart(const Vector<Number>& start){
+            NormalizeTo(start, w_);
+            auto first = basis_.RowData(0);
+            for (size_t index = 0; index < N_; index++){
+                first[index] = w_[index];
+            }
+            alphas_.clear();
+            betas_.clear();
+            locked_.clear();
+        }
+    public:
+        void Solve(){
+            while (count_iteration < kMaxCountIterations){
+                size_t size = 0;
+                bool converged = false;
+                while (size < max_basis_ && count_iteration < kMaxCountIterations && !converged){
+                    auto beta = OneStep(size);
+                    auto cur_eps_vector = RayleighRitz(++size);
+                    auto cur_eps_eigen_lambda = std::abs(previous_lambda_ - lambda_);
+                    //beta == 0: the Krylov space is invariant and the Ritz pairs are exact.
+                    //T_0 of a restart only repeats the last Ritz value, so lambda is compared from T_1 on
+                    converged = beta == 0 || cur_eps_vector <= kEpsEigenVector ||
+                                (size > 1 && cur_eps_eigen_lambda <= kEpsEigenLambda);
+                }
+                UpdateRitzVector(size);
+                if (converged) return;
+                Restart(x_);
+            }
+        }
+        //previous_lambda_, lambda_, x_, previous_x_, count_iteration (the number of mat-vecs);
+        //x_ is the normalized Ritz vector, previous_x_ the one of the previous restart
+        decltype(auto) GetAll(){
+            return std::tie(previous_lambda_, lambda_, x_, previous_x_, count_iteration);
+        }
+        LanczosSolver(size_t N,
+                      Operator matrix,
+                      Number lambda,
+                      Vector<Number> get_vector,
+                      size_t max_basis = kDefaultBasis) :
+                LanczosSolver(N, std::move(matrix), {EigenPair<Number>{lambda, std::move(get_vector)}}, max_basis) {}
+        //every pair of found is deflated from matrix
+        LanczosSolver(size_t N,
+                      Operator matrix,
+                      std::vector<EigenPair<Number>> found,
+                      size_t max_basis = kDefaultBasis) :
+                N_(N),
+                max_basis_(std::max<size_t>(std::min(max_basis, N), 1)),
+                A(std::move(matrix)),
+                x_(N_),
+                previous_x_(N_),
+                basis_(max_basis_, N_),
+                q_(N_),
+                w_(N_),
+                diagonal_(max_basis_),
+                off_diagonal_(max_basis_),
+                bottom_(max_basis_),
+                ritz_vectors_(max_basis_, max_basis_)
+        {
+            static_assert(kMin < kMax, "минимум должен быть меньше максимума");
+            if (N_ == 0 || A.nRows() != N_) throw std::invalid_argument("loh");
+            Distribution distribution_{kMin, kMax};
+            std::mt19937 number_generator_{kRandomSeed == RandomSeed::Yes ? std::random_device{}() : 0};
+            for (size_t index = 0; index < N_; index++){
+                x_[index] = distribution_(number_generator_);
+            }
+            for (auto& pair : found){
+                A.Deflate(std::move(pair));
+            }
+            alphas_.reserve(max_basis_);
+            betas_.reserve(max_basis_);
+            Restart(x_);
+        }
+    };
+}
+#endif
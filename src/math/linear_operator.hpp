@@ -0,0 +1,29 @@
+#pragma once
+#include <concepts>
+#include <cstddef>
+#include "matrix.hpp"
+#include "vector.hpp"
+
+namespace math {
+    //anything the power method can iterate on: y = A x through an overload of GemvDot
+    //that also returns (x, y)
+    template<typename Operator, typename T = double>
+    concept IsLinearOperator = requires(const Operator &op, const Vector<T> &x, Vector<T> &y) {
+        { op.nRows() } -> std::convertible_to<size_t>;
+        { GemvDot(op, x, y) } -> std::convertible_to<T>;
+    };
+
+    //the work vectors of a solver iterating on Operator: a matrix hands its allocator on to them
+    template<typename Operator, typename T>
+    struct OperatorVector {
+        using type = Vector<T>;
+    };
+
+    template<typename Info, typename Allocator, typename T>
+    struct OperatorVector<Matrix<Info, Allocator>, T> {
+        using type = Vector<T, RebindAllocator<Allocator, T>>;
+    };
+
+    template<typename Operator, typename T>
+    using OperatorVectorFor = typename OperatorVector<Operator, T>::type;
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include "matrix.hpp"
+#include "vector.hpp"
+
+namespace math {
+    //LU factorization with partial pivoting of (A - shift * E). The storage is kept between
+    //Factorize calls, so refactoring a matrix of the same size does not allocate
+    template<typename T = double>
+    class LuFactorization {
+        Matrix<T> lu_;
+        std::vector<size_t> pivots_;
+    public:
+        LuFactorization() = default;
+        explicit LuFactorization(const Matrix<T> &matrix, T shift = 0) {
+            Factorize(matrix, shift);
+        }
+
+        size_t nRows() const {
+            return lu_.nRows();
+        }
+
+        void Factorize(const Matrix<T> &matrix, T shift = 0) {
+            auto n = matrix.nRows();
+            if (n != matrix.nColumns()) throw std::invalid_argument("loh");
+            if (lu_.nRows() != n) {
+                lu_ = Matrix<T>(n, n);
+                pivots_.resize(n);
+            }
+            for (size_t i = 0; i < n; i++) {
+                std::copy(matrix.RowData(i), matrix.RowData(i) + n, lu_.RowData(i));
+                lu_.RowData(i)[i] -= shift;
+            }
+            T scale = 0;
+            for (size_t i = 0; i < n; i++)
+                for (size_t j = 0; j < n; j++)
+                    scale = std::max(scale, std::abs(lu_.RowData(i)[j]));
+            //a shift equal to an eigenvalue gives an exactly singular matrix, which is fine
+            //for inverse iteration: a tiny pivot only makes the solution grow along the eigenvector
+            auto tiny = std::max(scale, T{1}) * std::numeric_limits<T>::epsilon();
+            for (size_t k = 0; k < n; k++) {
+                size_t pivot = k;
+                for (size_t i = k + 1; i < n; i++)
+                    if (std::abs(lu_.RowData(i)[k]) > std::abs(lu_.RowData(pivot)[k])) pivot = i;
+                pivots_[k] = pivot;
+                if (pivot != k) {
+                    std::swap_ranges(lu_.RowData(k), lu_.RowData(k) + n, lu_.RowData(pivot));
+                }
+                auto row_k = lu_.RowData(k);
+                if (std::abs(row_k[k]) < tiny) row_k[k] = row_k[k] < 0 ? -tiny : tiny;
+                ParallelRows(n - k - 1, n - k, [&](size_t row_begin, size_t row_end) {
+                    for (size_t i = k + 1 + row_begin; i < k + 1 + row_end; i++) {
+                        auto row_i = lu_.RowData(i);
+                        auto factor = row_i[k] /= row_k[k];
+                        for (size_t j = k + 1; j < n; j++)
+                            row_i[j] -= factor * row_k[j];
+                    }
+                });
+            }
+        }
+
+        //solves (A - shift * E) x = b; x may be the same vector as b
+        template<typename VectorType>
+        void Solve(const VectorType &b, VectorType &x) const {
+            auto n = lu_.nRows();
+            if (b.size() != n || x.size() != n) throw std::invalid_argument("loh");
+            if (&x != &b) std::copy(b.begin(), b.end(), x.begin());
+            for (size_t k = 0; k < n; k++)
+                if (pivots_[k] != k) std::swap(x[k], x[pivots_[k]]);
+            for (size_t i = 0; i < n; i++) {
+                auto row = lu_.RowData(i);
+                T sum = x[i];
+                for (size_t j = 0; j < i; j++) sum -= row[j] * x[j];
+                x[i] = sum;
+            }
+            for (size_t i = n; i-- > 0;) {
+                auto row = lu_.RowData(i);
+                T sum = x[i];
+                for (size_t j = i + 1; j < n; j++) sum -= row[j] * x[j];
+                x[i] = sum / row[i];
+            }
+        }
+    };
+}
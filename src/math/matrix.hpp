@@ -2,11 +2,19 @@
 #include <utility>
 #include <cassert>
 #include <iostream>
+#include <memory>
 #include <vector>
 #include <type_traits>
 #include <algorithm>
 #include <cmath>
 #include <initializer_list>
+#include <stdexcept>
+#include "aligned_allocator.hpp"
+#include "strided_span.hpp"
+#include "view.hpp"
+#include "product.hpp"
+#include "parallel.hpp"
+#include "matrix_expression.hpp"
 
 namespace math {
 
@@ -34,48 +42,106 @@ namespace math {
         { left += right };
     };
 
+    //the allocator of Allocator's family for cells of type T
+    template<typename Allocator, typename T>
+    using RebindAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
 
-    template<typename Info = double>
+
+    //Allocator decides where the cells live: AlignedAllocator by default, ArenaAllocator or
+    //PoolAllocator for temporaries that should not reach malloc
+    template<typename Info = double, typename Allocator = AlignedAllocator<Info>>
     class Matrix {
     private:
         size_t rows_count_;
         size_t columns_count_;
-        std::vector<std::vector<Info>> m_cells;
-        void AllocateCells(int, int);
+        size_t stride_;
+        std::vector<Info, Allocator> m_cells;
+        void AllocateCells(size_t, size_t);
+        static size_t CountStride(size_t nCols);
+
+        template<typename Expression>
+        void Evaluate(const Expression &expression) {
+            ParallelRows(rows_count_, columns_count_, [&](size_t row_begin, size_t row_end) {
+                for (size_t i = row_begin; i < row_end; i++) {
+                    auto row = RowData(i);
+                    for (size_t j = 0; j < columns_count_; j++)
+                        row[j] = expression(i, j);
+                }
+            });
+        }
 
     public:
-        Matrix() : rows_count_(0), columns_count_(0) {}
+        using RowSpan = StridedSpan<Info>;
+        using ConstRowSpan = StridedSpan<const Info>;
+
+        Matrix() : rows_count_(0), columns_count_(0), stride_(0) {}
         Matrix(size_t size){
             AllocateCells(size, size);
         }
         Matrix(const Matrix &);
 
+        //takes the cells, the moved-from matrix is left empty
+        Matrix(Matrix &&another) noexcept :
+                rows_count_(std::exchange(another.rows_count_, 0)),
+                columns_count_(std::exchange(another.columns_count_, 0)),
+                stride_(std::exchange(another.stride_, 0)),
+                m_cells(std::move(another.m_cells)) {}
+
+        //copies the cells into the storage of another allocator
+        template<typename OtherAllocator>
+        requires (!std::is_same_v<OtherAllocator, Allocator>)
+        explicit Matrix(const Matrix<Info, OtherAllocator> &matrix){
+            AllocateCells(matrix.nRows(), matrix.nColumns());
+            for (size_t i = 0; i < rows_count_; i++)
+                std::copy(matrix.RowData(i), matrix.RowData(i) + columns_count_, RowData(i));
+        }
+
         Matrix(int, int);
         Matrix(std::initializer_list<std::initializer_list<Info>> list){
             size_t i = 0;
 
-            rows_count_ = list.size();
             assert(list.size() != 0);
-            columns_count_ = list.begin()->size();
-            AllocateCells(rows_count_, columns_count_);
+            AllocateCells(list.size(), list.begin()->size());
             for (auto& row: list){
                 size_t j = 0;
                 for (auto& elem : row){
-                    m_cells[i][j] = elem;
+                    (*this)[i][j] = elem;
                     j++;
                 }
                 i++;
             }
         }
+        //evaluates the whole expression in one pass over the result
+        template<typename Expression>
+        requires math::IsAssignable<Info, typename Expression::value_type>
+        Matrix(const MatrixExpression<Expression> &expression){
+            auto &self = expression.Self();
+            AllocateCells(self.nRows(), self.nColumns());
+            Evaluate(self);
+        }
+
+        //evaluated straight into the cells unless the expression reads them, e.g. m = Transposed(m)
+        template<typename Expression>
+        requires math::IsAssignable<Info, typename Expression::value_type>
+        Matrix &operator=(const MatrixExpression<Expression> &expression){
+            auto &self = expression.Self();
+            if (self.Reads(m_cells.data(), m_cells.data() + m_cells.size())) {
+                return *this = Matrix(expression);
+            }
+            if (self.nRows() != rows_count_ || self.nColumns() != columns_count_) {
+                AllocateCells(self.nRows(), self.nColumns());
+            }
+            Evaluate(self);
+            return *this;
+        }
+
         friend bool operator==(const Matrix& left, const Matrix& right){
             if (left.nRows() != right.rows_count_ || left.nColumns() != right.columns_count_){
                 return false;
             }
             for (size_t i = 0; i < left.rows_count_; i++){
-                for (size_t j = 0; j < left.columns_count_; j++){
-                    if (left.m_cells[i][j] != right.m_cells[i][j]){
-                        return false;
-                    }
+                if (!std::equal(left.RowData(i), left.RowData(i) + left.columns_count_, right.RowData(i))){
+                    return false;
                 }
             }
             return true;
@@ -84,201 +150,407 @@ namespace math {
             return !(*this == matrix);
         }
         Matrix(int n_nRows, int n_nCols, Info *list) {
-            int k = 0;
             AllocateCells(n_nRows, n_nCols);
-            for (int i = 0; i < n_nRows; i++)
-                for (int j = 0; j < n_nCols; j++) {
-                    m_cells[i][j] = list[k];
-                    k++;
-                }
+            for (size_t i = 0; i < rows_count_; i++, list += columns_count_)
+                std::copy(list, list + columns_count_, RowData(i));
         }
 
         size_t nRows() const;
 
         size_t nColumns() const;
 
-        decltype(auto) operator[](size_t i) {
-            return m_cells[i];
+        //distance in elements between the beginnings of neighbouring rows
+        size_t Stride() const {
+            return stride_;
+        }
+
+        Info *Data() {
+            return m_cells.data();
+        }
+
+        const Info *Data() const {
+            return m_cells.data();
+        }
+
+        Info *RowData(size_t i) {
+            return m_cells.data() + i * stride_;
+        }
+
+        const Info *RowData(size_t i) const {
+            return m_cells.data() + i * stride_;
+        }
+
+        MatrixView<Info> View() {
+            return MatrixView<Info>(Data(), rows_count_, columns_count_, stride_);
+        }
+
+        MatrixView<const Info> View() const {
+            return MatrixView<const Info>(Data(), rows_count_, columns_count_, stride_);
+        }
+
+        //zero-copy counterpart of Transposition
+        MatrixView<const Info> TransposedView() const {
+            return View().Transposed();
         }
 
-        decltype(auto) operator[](size_t i) const {
-            return m_cells[i];
+        ConstRowSpan Row(size_t i) const {
+            return View().Row(i);
+        }
+
+        ConstRowSpan Column(size_t j) const {
+            return View().Column(j);
+        }
+
+        MatrixView<const Info> Block(size_t row, size_t column, size_t rows, size_t columns) const {
+            return View().Block(row, column, rows, columns);
+        }
+
+        RowSpan operator[](size_t i) {
+            return RowSpan(RowData(i), columns_count_);
+        }
+
+        ConstRowSpan operator[](size_t i) const {
+            return ConstRowSpan(RowData(i), columns_count_);
         }
 
         auto Transposition() const {
-            auto &matrix = *this;
-            Matrix t_matrix(matrix.columns_count_, matrix.rows_count_);
-            for (size_t i = 0; i < matrix.rows_count_; i++)
-                for (size_t j = 0; j < matrix.columns_count_; j++)
-                    t_matrix[j][i] = matrix[i][j];
+            constexpr size_t kBlock = 32;
+            Matrix t_matrix(columns_count_, rows_count_);
+            auto blocks_count = (rows_count_ + kBlock - 1) / kBlock;
+            ParallelRows(blocks_count, kBlock * columns_count_, [&](size_t block_begin, size_t block_end) {
+                for (size_t ib = block_begin * kBlock; ib < std::min(block_end * kBlock, rows_count_); ib += kBlock)
+                    for (size_t jb = 0; jb < columns_count_; jb += kBlock) {
+                        auto i_end = std::min(ib + kBlock, rows_count_);
+                        auto j_end = std::min(jb + kBlock, columns_count_);
+                        for (size_t i = ib; i < i_end; i++) {
+                            auto row = RowData(i);
+                            for (size_t j = jb; j < j_end; j++)
+                                t_matrix.RowData(j)[i] = row[j];
+                        }
+                    }
+            });
             return t_matrix;
         }
 
-        Matrix &operator=(Matrix &&another) {
+        Matrix &operator=(Matrix &&another) noexcept {
             std::swap(m_cells, another.m_cells);
             std::swap(this->rows_count_, another.rows_count_);
             std::swap(this->columns_count_, another.columns_count_);
+            std::swap(this->stride_, another.stride_);
             return *this;
         }
 
-        template<typename RCell>
+        //both assignments have value semantics: the target takes the shape of right and
+        //keeps its own buffer whenever that buffer is large enough
+        template<typename RCell, typename RAllocator>
         requires math::IsAssignable<Info, RCell>
-        Matrix<Info> &operator=(const Matrix<RCell> &right) {
-            if (columns_count_ != right.columns_count_ || rows_count_ != right.rows_count_) {
-                throw std::invalid_argument("loh");
+        Matrix &operator=(const Matrix<RCell, RAllocator> &right) {
+            if (columns_count_ != right.nColumns() || rows_count_ != right.nRows()) {
+                AllocateCells(right.nRows(), right.nColumns());
             }
-            for (int i = 0; i < rows_count_; i++)
-                for (int j = 0; j < columns_count_; j++)
-                    m_cells[i][j] = right.m_cells[i][j];
-        }
-
-        template<typename LCell, typename RCell>
-        requires math::IsSummable<LCell, RCell>
-        friend auto operator+(const Matrix<LCell> &left, const Matrix<RCell> &right) {
-            if (left.rows_count_ != right.rows_count_ || left.columns_count_ != right.columns_count_)
-                throw std::invalid_argument("loh");
-            Matrix<decltype(std::declval<LCell>() + std::declval<RCell>())> res(left.rows_count_, left.columns_count_);
-            for (int i = 0; i < left.rows_count_; i++)
-                for (int j = 0; j < left.columns_count_; j++)
-                    res.m_cells[i][j] = left.m_cells[i][j] + right.m_cells[i][j];
-            return res;
+            for (size_t i = 0; i < rows_count_; i++)
+                std::copy(right.RowData(i), right.RowData(i) + columns_count_, RowData(i));
+            return *this;
         }
 
-        template<typename LCell, typename RCell>
-        requires math::IsDeductible<LCell, RCell>
-        friend auto operator-(const Matrix<LCell> &left, const Matrix<RCell> &right) {
-            if (left.rows_count_ != right.rows_count_ || left.columns_count_ != right.columns_count_)
-                throw std::invalid_argument("loh");
-            Matrix<decltype(std::declval<LCell>() - std::declval<RCell>())> res(left.rows_count_, left.columns_count_);
-            for (int i = 0; i < res.rows_count_; i++)
-                for (int j = 0; j < res.columns_count_; j++)
-                    res.m_cells[i][j] = left.m_cells[i][j] - right.m_cells[i][j];
-            return res;
+        Matrix &operator=(const Matrix &another) {
+            if (this == &another) return *this;
+            return operator=<Info, Allocator>(another);
         }
 
-        template<typename Cell, typename Denominator>
-        requires math::IsDeductible<Cell, Denominator>
-        friend auto operator/(Matrix<Cell> &left, const Denominator &denominator) {
-            auto copy = left;
-            for (auto &row: copy.m_cells) {
-                for (auto &elem: row) {
-                    elem = elem / denominator;
-                }
+        friend std::istream &operator>>(std::istream & in , Matrix & M){
+            for (size_t i = 0; i < M.rows_count_; i++)
+                for (size_t j = 0; j < M.columns_count_; j++)
+                    in >> M[i][j];
+            return in;
+        }
+
+        friend std::ostream &operator<<(std::ostream & out, const Matrix & M){
+            for (size_t i = 0; i < M.rows_count_; i++) {
+                for (size_t j = 0; j < M.columns_count_; j++)
+                    out << M[i][j] << '\t';
+                out << '\n';
             }
-            return copy;
-        }
-
-        template<typename Cell, typename Denominator>
-        requires math::IsDeductible<Cell, Denominator>
-        friend auto operator/=(Matrix<Cell> &left, const Denominator &denominator) {
-            left = left / denominator;
-            return left;
-        }
-
-        template<typename LCell, typename RCell>
-        requires math::IsMultiplied<LCell, RCell>
-        friend auto operator*(const Matrix<LCell> &left, const Matrix<RCell> &right) {
-            if (left.columns_count_ != right.rows_count_) throw std::invalid_argument("loh");
-            Matrix<decltype(std::declval<LCell>() * std::declval<RCell>())> res(left.rows_count_, right.columns_count_);
-            {
-                auto n = left.rows_count_;
-                auto m = left.columns_count_;
-                auto p = right.columns_count_;
-                for (int i = 0; i < n; i++) {
-                    for (int j = 0; j < p; j++) {
-                        res.m_cells[i][j] = 0;
-                        for (int k = 0; k < m; k++) {
-                            res.m_cells[i][j] += left.m_cells[i][k] * right.m_cells[k][j];
-                        }
+            return out;
+        }
+    };
 
-                    }
-                }
+    template<typename LCell, typename LAllocator, typename RCell, typename RAllocator>
+    requires math::IsSummable<LCell, RCell>
+    auto operator+(const Matrix<LCell, LAllocator> &left, const Matrix<RCell, RAllocator> &right) {
+        if (left.nRows() != right.nRows() || left.nColumns() != right.nColumns())
+            throw std::invalid_argument("loh");
+        using Result = decltype(std::declval<LCell>() + std::declval<RCell>());
+        Matrix<Result, RebindAllocator<LAllocator, Result>> res(left.nRows(), left.nColumns());
+        ParallelRows(res.nRows(), res.nColumns(), [&](size_t row_begin, size_t row_end) {
+            for (size_t i = row_begin; i < row_end; i++) {
+                auto l = left.RowData(i);
+                auto r = right.RowData(i);
+                auto out = res.RowData(i);
+                for (size_t j = 0; j < res.nColumns(); j++)
+                    out[j] = l[j] + r[j];
+            }
+        });
+        return res;
+    }
 
+    template<typename LCell, typename LAllocator, typename RCell, typename RAllocator>
+    requires math::IsDeductible<LCell, RCell>
+    auto operator-(const Matrix<LCell, LAllocator> &left, const Matrix<RCell, RAllocator> &right) {
+        if (left.nRows() != right.nRows() || left.nColumns() != right.nColumns())
+            throw std::invalid_argument("loh");
+        using Result = decltype(std::declval<LCell>() - std::declval<RCell>());
+        Matrix<Result, RebindAllocator<LAllocator, Result>> res(left.nRows(), left.nColumns());
+        ParallelRows(res.nRows(), res.nColumns(), [&](size_t row_begin, size_t row_end) {
+            for (size_t i = row_begin; i < row_end; i++) {
+                auto l = left.RowData(i);
+                auto r = right.RowData(i);
+                auto out = res.RowData(i);
+                for (size_t j = 0; j < res.nColumns(); j++)
+                    out[j] = l[j] - r[j];
             }
-            return res;
-        }
+        });
+        return res;
+    }
 
-        template<typename Cell, typename Right>
-        requires math::IsMultiplied<Cell, Right>
-        friend auto operator*(const Matrix<Cell> &left, const Right &right) {
-            Matrix<decltype(std::declval<Cell>() * std::declval<Right>())> res(left.rows_count_, left.columns_count_);
-            {
-                for (int i = 0; i < left.rows_count_; i++) {
-                    for (int j = 0; j < left.columns_count_; j++) {
-                        res.m_cells[i][j] = left.m_cells[i][j] * right;
-                    }
-                }
+    //left[i][j] = operation(left[i][j], right[i][j]) row by row, the in-place kernel of the
+    //compound operators and of the overloads that reuse a temporary operand
+    template<typename Cell, typename Allocator, typename RCell, typename RAllocator, typename Operation>
+    void ApplyInPlace(Matrix<Cell, Allocator> &left, const Matrix<RCell, RAllocator> &right, Operation operation) {
+        if (left.nRows() != right.nRows() || left.nColumns() != right.nColumns())
+            throw std::invalid_argument("loh");
+        ParallelRows(left.nRows(), left.nColumns(), [&](size_t row_begin, size_t row_end) {
+            for (size_t i = row_begin; i < row_end; i++) {
+                auto out = left.RowData(i);
+                auto r = right.RowData(i);
+                for (size_t j = 0; j < left.nColumns(); j++)
+                    out[j] = operation(out[j], r[j]);
             }
-            return res;
+        });
+    }
+
+    template<typename Cell, typename Allocator, typename Operation>
+    void ApplyInPlace(Matrix<Cell, Allocator> &matrix, Operation operation) {
+        for (size_t i = 0; i < matrix.nRows(); i++) {
+            auto row = matrix.RowData(i);
+            for (size_t j = 0; j < matrix.nColumns(); j++)
+                row[j] = operation(row[j]);
         }
+    }
 
-        template<typename Left, typename Cell>
-        requires math::IsMultiplied<Left, Cell>
-        friend auto operator*(const Left &left, const Matrix<Cell> &right) {
-            Matrix<decltype(std::declval<Left>() * std::declval<Cell>())> res(right.rows_count_, right.columns_count_);
-            {
-                for (int i = 0; i < right.rows_count_; i++) {
-                    for (int j = 0; j < right.columns_count_; j++) {
-                        res.m_cells[i][j] = left * right.m_cells[i][j];
-                    }
+    template<typename Cell, typename Allocator, typename RCell, typename RAllocator>
+    requires math::IsSummable<Cell, RCell>
+    Matrix<Cell, Allocator> &operator+=(Matrix<Cell, Allocator> &left, const Matrix<RCell, RAllocator> &right) {
+        ApplyInPlace(left, right, [](Cell l, RCell r) { return l + r; });
+        return left;
+    }
+
+    template<typename Cell, typename Allocator, typename RCell, typename RAllocator>
+    requires math::IsDeductible<Cell, RCell>
+    Matrix<Cell, Allocator> &operator-=(Matrix<Cell, Allocator> &left, const Matrix<RCell, RAllocator> &right) {
+        ApplyInPlace(left, right, [](Cell l, RCell r) { return l - r; });
+        return left;
+    }
+
+    template<typename Cell, typename Allocator, typename Scalar>
+    requires std::is_arithmetic_v<Scalar> && math::IsMultiplied<Cell, Scalar>
+    Matrix<Cell, Allocator> &operator*=(Matrix<Cell, Allocator> &left, const Scalar &scalar) {
+        ApplyInPlace(left, [&](Cell cell) { return cell * scalar; });
+        return left;
+    }
+
+    template<typename Cell, typename Allocator, typename Denominator>
+    requires math::IsDeductible<Cell, Denominator>
+    Matrix<Cell, Allocator> &operator/=(Matrix<Cell, Allocator> &left, const Denominator &denominator) {
+        ApplyInPlace(left, [&](Cell cell) { return cell / denominator; });
+        return left;
+    }
+
+    template<typename Cell, typename Allocator, typename Denominator>
+    requires math::IsDeductible<Cell, Denominator>
+    auto operator/(const Matrix<Cell, Allocator> &left, const Denominator &denominator) {
+        auto copy = left;
+        copy /= denominator;
+        return copy;
+    }
+
+    //a temporary operand gives its buffer to the result when the cell type does not change
+    template<typename Cell, typename Allocator, typename Denominator>
+    requires math::IsDeductible<Cell, Denominator>
+    Matrix<Cell, Allocator> operator/(Matrix<Cell, Allocator> &&left, const Denominator &denominator) {
+        left /= denominator;
+        return std::move(left);
+    }
+
+    template<typename Cell, typename Allocator, typename RCell, typename RAllocator>
+    requires std::is_same_v<decltype(std::declval<Cell>() + std::declval<RCell>()), Cell>
+    Matrix<Cell, Allocator> operator+(Matrix<Cell, Allocator> &&left, const Matrix<RCell, RAllocator> &right) {
+        left += right;
+        return std::move(left);
+    }
+
+    template<typename LCell, typename LAllocator, typename Cell, typename Allocator>
+    requires std::is_same_v<decltype(std::declval<LCell>() + std::declval<Cell>()), Cell>
+    Matrix<Cell, Allocator> operator+(const Matrix<LCell, LAllocator> &left, Matrix<Cell, Allocator> &&right) {
+        ApplyInPlace(right, left, [](Cell r, LCell l) { return l + r; });
+        return std::move(right);
+    }
+
+    template<typename Cell, typename Allocator, typename RCell, typename RAllocator>
+    requires std::is_same_v<decltype(std::declval<Cell>() + std::declval<RCell>()), Cell>
+    Matrix<Cell, Allocator> operator+(Matrix<Cell, Allocator> &&left, Matrix<RCell, RAllocator> &&right) {
+        left += right;
+        return std::move(left);
+    }
+
+    template<typename Cell, typename Allocator, typename RCell, typename RAllocator>
+    requires std::is_same_v<decltype(std::declval<Cell>() - std::declval<RCell>()), Cell>
+    Matrix<Cell, Allocator> operator-(Matrix<Cell, Allocator> &&left, const Matrix<RCell, RAllocator> &right) {
+        left -= right;
+        return std::move(left);
+    }
+
+    template<typename LCell, typename LAllocator, typename Cell, typename Allocator>
+    requires std::is_same_v<decltype(std::declval<LCell>() - std::declval<Cell>()), Cell>
+    Matrix<Cell, Allocator> operator-(const Matrix<LCell, LAllocator> &left, Matrix<Cell, Allocator> &&right) {
+        ApplyInPlace(right, left, [](Cell r, LCell l) { return l - r; });
+        return std::move(right);
+    }
+
+    template<typename Cell, typename Allocator, typename RCell, typename RAllocator>
+    requires std::is_same_v<decltype(std::declval<Cell>() - std::declval<RCell>()), Cell>
+    Matrix<Cell, Allocator> operator-(Matrix<Cell, Allocator> &&left, Matrix<RCell, RAllocator> &&right) {
+        left -= right;
+        return std::move(left);
+    }
+
+    template<typename Cell, typename Allocator, typename Scalar>
+    requires std::is_arithmetic_v<Scalar> && std::is_same_v<decltype(std::declval<Cell>() * std::declval<Scalar>()), Cell>
+    Matrix<Cell, Allocator> operator*(Matrix<Cell, Allocator> &&left, const Scalar &scalar) {
+        left *= scalar;
+        return std::move(left);
+    }
+
+    template<typename Scalar, typename Cell, typename Allocator>
+    requires std::is_arithmetic_v<Scalar> && std::is_same_v<decltype(std::declval<Scalar>() * std::declval<Cell>()), Cell>
+    Matrix<Cell, Allocator> operator*(const Scalar &scalar, Matrix<Cell, Allocator> &&right) {
+        ApplyInPlace(right, [&](Cell cell) { return scalar * cell; });
+        return std::move(right);
+    }
+
+    template<typename LCell, typename LAllocator, typename RCell, typename RAllocator>
+    requires math::IsMultiplied<LCell, RCell>
+    auto operator*(const Matrix<LCell, LAllocator> &left, const Matrix<RCell, RAllocator> &right) {
+        if (left.nColumns() != right.nRows()) throw std::invalid_argument("loh");
+        using Result = decltype(std::declval<LCell>() * std::declval<RCell>());
+        Matrix<Result, RebindAllocator<LAllocator, Result>> res(left.nRows(), right.nColumns());
+        if constexpr (std::is_same_v<LCell, RCell> && std::is_same_v<LCell, Result>) {
+            MultiplyTo(left.View(), right.View(), res.View());
+            return res;
+        }
+        auto n = left.nRows();
+        auto m = left.nColumns();
+        auto p = right.nColumns();
+        for (size_t i = 0; i < n; i++) {
+            auto l = left.RowData(i);
+            auto out = res.RowData(i);
+            for (size_t k = 0; k < m; k++) {
+                auto r = right.RowData(k);
+                for (size_t j = 0; j < p; j++) {
+                    out[j] += l[k] * r[j];
                 }
             }
-            return res;
         }
+        return res;
+    }
 
-        friend std::istream &operator>>(std::istream & in , Matrix & M){
-            for (int i = 0; i < M.rows_count_; i++)
-                for (int j = 0; j < M.columns_count_; j++)
-                    in >> M.m_cells[i][j];
-            return in;
+    template<typename Cell, typename Allocator, typename Right>
+    requires math::IsMultiplied<Cell, Right>
+    auto operator*(const Matrix<Cell, Allocator> &left, const Right &right) {
+        using Result = decltype(std::declval<Cell>() * std::declval<Right>());
+        Matrix<Result, RebindAllocator<Allocator, Result>> res(left.nRows(), left.nColumns());
+        for (size_t i = 0; i < left.nRows(); i++) {
+            auto l = left.RowData(i);
+            auto out = res.RowData(i);
+            for (size_t j = 0; j < left.nColumns(); j++) {
+                out[j] = l[j] * right;
+            }
         }
+        return res;
+    }
 
-        friend std::ostream &operator<<(std::ostream & out, const Matrix & M){
-            for (int i = 0; i < M.rows_count_; i++) {
-                for (int j = 0; j < M.columns_count_; j++)
-                    out << M.m_cells[i][j] << '\t';
-                out << '\n';
+    template<typename Left, typename Cell, typename Allocator>
+    requires math::IsMultiplied<Left, Cell>
+    auto operator*(const Left &left, const Matrix<Cell, Allocator> &right) {
+        using Result = decltype(std::declval<Left>() * std::declval<Cell>());
+        Matrix<Result, RebindAllocator<Allocator, Result>> res(right.nRows(), right.nColumns());
+        for (size_t i = 0; i < right.nRows(); i++) {
+            auto r = right.RowData(i);
+            auto out = res.RowData(i);
+            for (size_t j = 0; j < right.nColumns(); j++) {
+                out[j] = left * r[j];
             }
-            return out;
         }
-    };
+        return res;
+    }
+
+    template<typename LCell, typename RCell>
+    requires std::is_same_v<std::remove_const_t<LCell>, std::remove_const_t<RCell>>
+    auto operator*(const MatrixView<LCell> &left, const MatrixView<RCell> &right) {
+        Matrix<std::remove_const_t<LCell>> res(left.nRows(), right.nColumns());
+        MultiplyTo<std::remove_const_t<LCell>>(left, right, res.View());
+        return res;
+    }
+
+    template<typename LCell, typename LAllocator, typename RCell>
+    requires std::is_same_v<LCell, std::remove_const_t<RCell>>
+    auto operator*(const Matrix<LCell, LAllocator> &left, const MatrixView<RCell> &right) {
+        return left.View() * right;
+    }
 
-    template<typename Info>
-    Matrix<Info>::Matrix(const Matrix<Info> &M) {
-        AllocateCells(M.rows_count_, M.columns_count_);
-        for (int i = 0; i < rows_count_; i++)
-            for (int j = 0; j < columns_count_; j++)
-                m_cells[i][j] = M.m_cells[i][j];
+    template<typename LCell, typename RCell, typename RAllocator>
+    requires std::is_same_v<std::remove_const_t<LCell>, RCell>
+    auto operator*(const MatrixView<LCell> &left, const Matrix<RCell, RAllocator> &right) {
+        return left * right.View();
     }
 
-    template<typename Info>
-    Matrix<Info>::Matrix(int n_nRows, int n_nCols) {
+    template<typename Info, typename Allocator>
+    Matrix<Info, Allocator>::Matrix(const Matrix &M) :
+            rows_count_(M.rows_count_),
+            columns_count_(M.columns_count_),
+            stride_(M.stride_),
+            m_cells(M.m_cells) {}
+
+    template<typename Info, typename Allocator>
+    Matrix<Info, Allocator>::Matrix(int n_nRows, int n_nCols) {
         AllocateCells(n_nRows, n_nCols);
-        for (int i = 0; i < n_nRows; i++)
-            for (int j = 0; j < n_nCols; j++)
-                m_cells[i][j] = 0;
     }
 
+    template<typename Info, typename Allocator>
+    size_t Matrix<Info, Allocator>::CountStride(size_t nCols) {
+        //rows longer than a cache line are padded so that each of them starts on an aligned address
+        constexpr size_t kLineElements = std::max<size_t>(kCacheLineSize / sizeof(Info), 1);
+        if (nCols * sizeof(Info) <= kCacheLineSize) {
+            return nCols;
+        }
+        return (nCols + kLineElements - 1) / kLineElements * kLineElements;
+    }
 
-    template<typename Info>
-    void Matrix<Info>::AllocateCells(int nRows, int nCols) {
+    template<typename Info, typename Allocator>
+    void Matrix<Info, Allocator>::AllocateCells(size_t nRows, size_t nCols) {
         rows_count_ = nRows;
         columns_count_ = nCols;
-
-        m_cells.resize(nRows);
-        std::for_each(
-                m_cells.begin(),
-                m_cells.end(),
-                [nCols](std::vector<Info> &elem) { elem.resize(nCols); });
+        stride_ = CountStride(nCols);
+        m_cells.assign(nRows * stride_, Info{});
     }
 
-    template<typename Info>
-    size_t Matrix<Info>::nRows() const {
+    template<typename Info, typename Allocator>
+    size_t Matrix<Info, Allocator>::nRows() const {
         return rows_count_;
     }
 
-    template<typename Info>
-    size_t Matrix<Info>::nColumns() const {
+    template<typename Info, typename Allocator>
+    size_t Matrix<Info, Allocator>::nColumns() const {
         return columns_count_;
     }
 
@@ -291,17 +563,19 @@ namespace math {
         return matrix;
     }
 
-    double Abs(Matrix<>& matrix){
+    template<typename Info, typename Allocator>
+    double Abs(const Matrix<Info, Allocator>& matrix){
         double sum = 0;
         for (size_t i = 0; i < matrix.nRows(); i++){
+            auto row = matrix.RowData(i);
             for (size_t j = 0; j < matrix.nColumns(); j++){
-                sum += pow(matrix[i][j], 2);
+                sum += row[j] * row[j];
             }
         }
         return sqrt(sum);
     }
     template <typename TMatrix>
-    double Abs(TMatrix& matrix){
+    double Abs(const TMatrix& matrix){
         double sum = 0;
         for (size_t j = 0; j < matrix.size(); j++){
             sum += pow(matrix[j], 2);
@@ -309,8 +583,10 @@ namespace math {
         return sqrt(sum);
     }
 
+    //a temporary argument is normalized in its own buffer
     template <typename TMatrix>
     auto Normalized(TMatrix&& matrix){
-        return matrix/Abs(matrix);
+        auto norm = Abs(matrix);
+        return std::forward<TMatrix>(matrix) / norm;
     }
 }
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <type_traits>
+
+namespace math {
+    //[first, last] against [begin, end) in the total pointer order of std::less
+    inline bool Overlaps(const void *first, const void *last, const void *begin, const void *end) {
+        std::less<const void *> less;
+        return less(first, end) && !less(last, begin);
+    }
+
+    //CRTP base of lazily evaluated matrices. Derived provides value_type, nRows(), nColumns()
+    //and operator()(i, j); the element is computed only when it is read
+    template<typename Derived>
+    struct MatrixExpression {
+        const Derived &Self() const {
+            return static_cast<const Derived &>(*this);
+        }
+
+        //true when the expression may read the memory [begin, end): a Matrix is assigned in place
+        //only if the expression does not read its cells. Derived that knows better hides this
+        bool Reads(const void *, const void *) const {
+            return true;
+        }
+
+        friend std::ostream &operator<<(std::ostream &out, const MatrixExpression &expression) {
+            auto &self = expression.Self();
+            for (size_t i = 0; i < self.nRows(); i++) {
+                for (size_t j = 0; j < self.nColumns(); j++)
+                    out << self(i, j) << '\t';
+                out << '\n';
+            }
+            return out;
+        }
+    };
+
+    template<typename T>
+    concept IsMatrixExpression = std::is_base_of_v<MatrixExpression<std::remove_cvref_t<T>>, std::remove_cvref_t<T>>;
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include "utils/thread_pool.hpp"
+
+namespace math {
+    //minimal amount of elementary operations that is worth sending to another thread
+    inline constexpr size_t kParallelMinWork = size_t{1} << 16;
+
+    inline bool IsWorthParallel(size_t rows, size_t row_cost) {
+        return rows > 1 && rows * row_cost >= 2 * kParallelMinWork &&
+               utils::ThreadPool::Shared().ThreadsCount() > 1;
+    }
+
+    //calls function(row_begin, row_end) over [0, rows), splitting the rows between the threads
+    //of the shared pool when rows * row_cost is large enough; small inputs run sequentially
+    template<typename Function>
+    void ParallelRows(size_t rows, size_t row_cost, Function &&function) {
+        if (!IsWorthParallel(rows, row_cost)) {
+            function(size_t{0}, rows);
+            return;
+        }
+        auto &pool = utils::ThreadPool::Shared();
+        auto grain = std::max(kParallelMinWork / std::max<size_t>(row_cost, 1),
+                              rows / (4 * pool.ThreadsCount()));
+        pool.ParallelFor(0, rows, std::max<size_t>(grain, 1), function);
+    }
+}
@@ -0,0 +1,120 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include "aligned_allocator.hpp"
+
+namespace math {
+    //free lists of blocks rounded up to powers of two: a freed block waits in its list and the
+    //next request of the same class takes it back, so temporaries of recurring sizes stop
+    //reaching malloc. Blocks above kMaxPooledBytes go straight to operator new
+    class SizeClassPool {
+        struct FreeBlock {
+            FreeBlock *next;
+        };
+
+        static constexpr size_t kMinPooledBytes = kCacheLineSize;
+        static constexpr size_t kClassesCount = 17;
+        std::array<FreeBlock *, kClassesCount> free_{};
+        size_t cached_ = 0;
+
+        static size_t ClassOf(size_t bytes) {
+            return std::bit_width((std::max(bytes, kMinPooledBytes) - 1) / kMinPooledBytes);
+        }
+
+        static size_t ClassSize(size_t size_class) {
+            return kMinPooledBytes << size_class;
+        }
+
+        static void *AllocateBlock(size_t bytes) {
+            return ::operator new(bytes, std::align_val_t{kCacheLineSize});
+        }
+
+        static void FreeBlockMemory(void *ptr) noexcept {
+            ::operator delete(ptr, std::align_val_t{kCacheLineSize});
+        }
+    public:
+        static constexpr size_t kMaxPooledBytes = kMinPooledBytes << (kClassesCount - 1);
+
+        SizeClassPool() = default;
+        SizeClassPool(const SizeClassPool &) = delete;
+        SizeClassPool &operator=(const SizeClassPool &) = delete;
+
+        ~SizeClassPool() {
+            Release();
+        }
+
+        void *Allocate(size_t bytes) {
+            if (bytes > kMaxPooledBytes) return AllocateBlock(bytes);
+            auto size_class = ClassOf(bytes);
+            if (auto block = free_[size_class]) {
+                free_[size_class] = block->next;
+                cached_ -= ClassSize(size_class);
+                return block;
+            }
+            return AllocateBlock(ClassSize(size_class));
+        }
+
+        void Deallocate(void *ptr, size_t bytes) noexcept {
+            if (bytes > kMaxPooledBytes) {
+                FreeBlockMemory(ptr);
+                return;
+            }
+            auto size_class = ClassOf(bytes);
+            free_[size_class] = new(ptr) FreeBlock{free_[size_class]};
+            cached_ += ClassSize(size_class);
+        }
+
+        //bytes waiting in the free lists
+        size_t Cached() const { return cached_; }
+
+        //returns the cached blocks to the system
+        void Release() noexcept {
+            for (auto &head: free_) {
+                while (head) {
+                    auto next = head->next;
+                    FreeBlockMemory(head);
+                    head = next;
+                }
+            }
+            cached_ = 0;
+        }
+    };
+
+    //the pool of the calling thread used by PoolAllocator
+    inline SizeClassPool &ThreadSizeClassPool() {
+        thread_local SizeClassPool pool;
+        return pool;
+    }
+
+    //stateless allocator over ThreadSizeClassPool; a block freed on another thread joins that thread's lists
+    template<typename T>
+    class PoolAllocator {
+        static_assert(alignof(T) <= kCacheLineSize, "выравнивание больше строки кэша");
+    public:
+        using value_type = T;
+
+        PoolAllocator() noexcept = default;
+        template<typename U>
+        PoolAllocator(const PoolAllocator<U> &) noexcept {}
+
+        T *allocate(size_t count) {
+            if (count > std::numeric_limits<size_t>::max() / sizeof(T)) {
+                throw std::bad_array_new_length();
+            }
+            return static_cast<T *>(ThreadSizeClassPool().Allocate(count * sizeof(T)));
+        }
+
+        void deallocate(T *ptr, size_t count) noexcept {
+            ThreadSizeClassPool().Deallocate(ptr, count * sizeof(T));
+        }
+
+        template<typename U>
+        friend bool operator==(const PoolAllocator &, const PoolAllocator<U> &) noexcept {
+            return true;
+        }
+    };
+}
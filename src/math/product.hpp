@@ -0,0 +1,134 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include "view.hpp"
+#include "gemm.hpp"
+#include "gemv.hpp"
+#include "parallel.hpp"
+
+namespace math {
+    namespace detail {
+        inline constexpr size_t kDotProductBlockColumns = 64;
+        inline constexpr size_t kDotProductBlockDepth = 256;
+
+        //C += A * B^T where A and B are both row-major: every element of C is a dot product of two rows
+        template<typename T>
+        void MultiplyByTransposed(const MatrixView<const T> &a, const MatrixView<const T> &b_transposed,
+                                  const MatrixView<T> &c, size_t row_begin, size_t row_end) {
+            auto depth = a.nColumns();
+            for (size_t jb = 0; jb < c.nColumns(); jb += kDotProductBlockColumns) {
+                auto j_end = std::min(jb + kDotProductBlockColumns, c.nColumns());
+                for (size_t pb = 0; pb < depth; pb += kDotProductBlockDepth) {
+                    auto block_depth = std::min(kDotProductBlockDepth, depth - pb);
+                    for (size_t i = row_begin; i < row_end; i++) {
+                        auto a_row = &a(i, pb);
+                        for (size_t j = jb; j < j_end; j++) {
+                            c(i, j) += Dot(block_depth, a_row, &b_transposed(pb, j));
+                        }
+                    }
+                }
+            }
+        }
+
+        template<typename T>
+        void MultiplyStrided(const MatrixView<const T> &a, const MatrixView<const T> &b,
+                             const MatrixView<T> &c, size_t row_begin, size_t row_end) {
+            auto contiguous = b.IsRowMajor() && c.IsRowMajor();
+            for (size_t i = row_begin; i < row_end; i++) {
+                for (size_t k = 0; k < a.nColumns(); k++) {
+                    auto a_value = a(i, k);
+                    if (contiguous) {
+                        auto b_row = &b(k, 0);
+                        auto c_row = &c(i, 0);
+                        for (size_t j = 0; j < c.nColumns(); j++)
+                            c_row[j] += a_value * b_row[j];
+                    } else {
+                        for (size_t j = 0; j < c.nColumns(); j++)
+                            c(i, j) += a_value * b(k, j);
+                    }
+                }
+            }
+        }
+    }
+
+    template<typename LCell, typename RCell>
+    requires std::is_same_v<std::remove_const_t<LCell>, std::remove_const_t<RCell>>
+    auto Dot(const StridedSpan<LCell> &left, const StridedSpan<RCell> &right) {
+        using T = std::remove_const_t<LCell>;
+        if (left.size() != right.size()) throw std::invalid_argument("loh");
+        if (left.IsContiguous() && right.IsContiguous()) {
+            return Dot<T>(left.size(), left.Data(), right.Data());
+        }
+        T sum{};
+        for (size_t i = 0; i < left.size(); i++)
+            sum += left[i] * right[i];
+        return sum;
+    }
+
+    //C += A * B for views of any layout; the layout picks the kernel:
+    //row-major operands go to Gemm, A * B^T of row-major matrices to row dot products
+    template<typename T>
+    void MultiplyTo(const MatrixView<const std::type_identity_t<T>> &a, const MatrixView<const std::type_identity_t<T>> &b,
+                    const MatrixView<T> &c) {
+        if (a.nColumns() != b.nRows() || a.nRows() != c.nRows() || b.nColumns() != c.nColumns())
+            throw std::invalid_argument("loh");
+        auto depth = a.nColumns();
+        auto columns = b.nColumns();
+        ParallelRows(a.nRows(), depth * columns, [&](size_t row_begin, size_t row_end) {
+            if (a.IsRowMajor() && b.IsRowMajor() && c.IsRowMajor()) {
+                Gemm(row_end - row_begin, columns, depth,
+                     a.Row(row_begin).Data(), a.RowStride(), b.Data(), b.RowStride(),
+                     c.Row(row_begin).Data(), c.RowStride());
+            } else if (a.IsRowMajor() && b.RowStride() == 1) {
+                detail::MultiplyByTransposed(a, b, c, row_begin, row_end);
+            } else {
+                detail::MultiplyStrided(a, b, c, row_begin, row_end);
+            }
+        });
+    }
+
+    //y = A * x; returns (x, y) over the first min(rows, columns) elements
+    template<typename T>
+    T GemvDot(const MatrixView<const std::type_identity_t<T>> &a, const StridedSpan<const std::type_identity_t<T>> &x,
+              const StridedSpan<T> &y) {
+        auto rows = a.nRows();
+        auto columns = a.nColumns();
+        if (columns != x.size() || rows != y.size())
+            throw std::invalid_argument("loh");
+        auto dense = x.IsContiguous() && y.IsContiguous();
+        if (dense && a.IsRowMajor()) {
+            if (!IsWorthParallel(rows, columns)) {
+                return GemvDot(rows, columns, a.Data(), a.RowStride(), x.Data(), y.Data());
+            }
+            ParallelRows(rows, columns, [&](size_t row_begin, size_t row_end) {
+                Gemv(row_end - row_begin, columns, a.Row(row_begin).Data(), a.RowStride(), x.Data(), y.Data() + row_begin);
+            });
+        } else if (dense && a.RowStride() == 1) {
+            //transposed row-major matrix: y is accumulated from contiguous columns of A
+            ParallelRows(rows, columns, [&](size_t row_begin, size_t row_end) {
+                std::fill(y.Data() + row_begin, y.Data() + row_end, T{});
+                for (size_t j = 0; j < columns; j++) {
+                    auto x_value = x[j];
+                    auto column = &a(0, j);
+                    for (size_t i = row_begin; i < row_end; i++)
+                        y.Data()[i] += column[i] * x_value;
+                }
+            });
+        } else {
+            ParallelRows(rows, columns, [&](size_t row_begin, size_t row_end) {
+                for (size_t i = row_begin; i < row_end; i++) {
+                    T sum{};
+                    for (size_t j = 0; j < columns; j++)
+                        sum += a(i, j) * x[j];
+                    y[i] = sum;
+                }
+            });
+        }
+        T dot{};
+        for (size_t i = 0; i < std::min(rows, columns); i++)
+            dot += x[i] * y[i];
+        return dot;
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include "cpu_features.hpp"
+
+namespace math {
+    template<typename T>
+    concept IsSimdReal = std::is_same_v<T, double> || std::is_same_v<T, float>;
+}
+
+namespace math::detail {
+#if MATH_HAS_X86_SIMD
+    template<typename T, size_t Width>
+    struct SimdVector {
+        typedef T type __attribute__((vector_size(Width * sizeof(T))));
+    };
+
+    template<typename V, typename T>
+    [[gnu::always_inline]] inline void SimdLoad(V &value, const T *ptr) {
+        std::memcpy(&value, ptr, sizeof(V));
+    }
+
+    template<typename V, typename T>
+    [[gnu::always_inline]] inline void SimdStore(T *ptr, const V &value) {
+        std::memcpy(ptr, &value, sizeof(V));
+    }
+
+    template<typename T, typename V>
+    [[gnu::always_inline]] inline T SimdSum(const V &value) {
+        T sum{};
+        for (size_t i = 0; i < sizeof(V) / sizeof(T); i++) {
+            sum += value[i];
+        }
+        return sum;
+    }
+#endif
+}
@@ -3,18 +3,49 @@
 #include <iostream>
 #include <type_traits>
 #include "matrix.hpp"
+#include "vector.hpp"
+#include "expression.hpp"
+#include "deflated_operator.hpp"
+#include "lu.hpp"
+#include "solver_observer.hpp"
+#include "utils/log.hpp"
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cmath>
+#include <optional>
 #include <random>
+#include <tuple>
+#include <vector>
 
 //m*n X n*p -> m*p
 //n*n -> n*1 = n*1
 //1*n X n*n -> 1*n*
 
-#define Print(matrix) std::cout << #matrix << '\n'; \
-std::cout << matrix << '\n';
-
 namespace math {
+    //None - plain power method;
+    //Aitken - delta-squared extrapolation of the lambda sequence;
+    //Shift - power method on A - kShift * E (Wielandt shift), removes kShift from the spectrum;
+    //ShiftInvert - power method on (A - kShift * E)^-1 through one LU factorization, finds lambda closest to kShift;
+    //RayleighQuotient - shift-invert with the shift moved to the current lambda, refactoring the same LU storage
+    enum struct Acceleration{
+        None, Aitken, Shift, ShiftInvert, RayleighQuotient
+    };
+
+    //Full - every iteration in Number;
+    //Mixed - iterations in float until float stops improving lambda and x, then Number
+    //until kEpsEigenVector/kEpsEigenLambda; the float copy halves the memory traffic of a mat-vec
+    enum struct Precision{
+        Full, Mixed
+    };
+
+    //Difference - max |x - previous x| <= kEpsEigenVector, x not normalized;
+    //Residual - ||A v - lambda v|| <= kEpsEigenVector for the normalized v of the step.
+    //Either is computed in the same pass that gives |x|^2 to the next normalization
+    enum struct Criterion{
+        Difference, Residual
+    };
+
     template<typename Number>
     struct Traits{
         Number kMin;
@@ -22,6 +53,12 @@ namespace math {
         double kEpsEigenVector;
         double kEpsEigenLambda;
         size_t kMaxCountIterations;
+        Acceleration kAcceleration = Acceleration::None;
+        double kShift = 0;
+        Precision kPrecision = Precision::Full;
+        //convergence is tested after every kCheckInterval-th step only
+        size_t kCheckInterval = 1;
+        Criterion kCriterion = Criterion::Difference;
     };
 
     enum struct RandomSeed{
@@ -31,79 +68,316 @@ namespace math {
     template<typename Number,
             Traits<Number> traits,
             RandomSeed kRandomSeed,
-            typename Distribution>
+            typename Distribution,
+            typename Operator = Matrix<Number>,
+            typename Observer = NoObserver>
+    requires IsLinearOperator<Operator, Number> && IsSolverObserver<Observer>
     class Solver{
         static constexpr auto kMin = traits.kMin;
         static constexpr auto kMax = traits.kMax;
         static constexpr auto kEpsEigenVector = traits.kEpsEigenVector;
         static constexpr auto kEpsEigenLambda = traits.kEpsEigenLambda;
         static constexpr auto kMaxCountIterations = traits.kMaxCountIterations;
+        static constexpr auto kAcceleration = traits.kAcceleration;
+        static constexpr auto kShift = traits.kShift;
+        static constexpr auto kCheckInterval = traits.kCheckInterval;
+        static constexpr bool kResidual = traits.kCriterion == Criterion::Residual;
+        static constexpr double kRayleighSwitch = 1e-4;
+        static constexpr bool kInverse = kAcceleration == Acceleration::ShiftInvert ||
+                                         kAcceleration == Acceleration::RayleighQuotient;
+        static constexpr bool kMixed = traits.kPrecision == Precision::Mixed;
+        //relative change of x below which float iterations stop paying off
+        static constexpr double kLowPrecisionSwitch = 1e-5;
+        //the float phase leaves at least a quarter of kMaxCountIterations to the refinement in Number
+        static constexpr size_t kMaxLowIterations = kMaxCountIterations - kMaxCountIterations / 4;
+        using LowOperator = DeflatedOperator<Matrix<float>, float>;
+        static constexpr bool kObserved = !std::is_same_v<Observer, NoObserver>;
+        using Clock = std::chrono::steady_clock;
+        //the work vectors take the allocator of a dense Operator
+        using WorkVector = OperatorVectorFor<Operator, Number>;
         size_t N_;
-        Matrix<> A;
-        double previous_lambda_;
-        double lambda_;
-        Matrix<> get_vector_;
-        Matrix<> x_;
-        Matrix<> previous_x_;
+        DeflatedOperator<Operator, Number> A;
+        Number previous_lambda_;
+        Number lambda_;
+        WorkVector x_;
+        WorkVector previous_x_;
+        WorkVector v_;
         size_t count_iteration = 0;
+        //raw Rayleigh quotients of the last two steps for Aitken extrapolation
+        Number raw_lambdas_[2]{};
+        //only for the inverse modes: the deflated matrix and its factorization
+        Matrix<Number> dense_;
+        LuFactorization<Number> lu_;
+        Number shift_ = kShift;
+        Number lambda_delta_ = 0;
+        //only for the mixed precision: float copies of A and of the work vectors
+        std::optional<LowOperator> low_;
+        Vector<float> low_x_;
+        Vector<float> low_previous_x_;
+        Vector<float> low_v_;
+        Observer observer_;
+        Clock::time_point step_start_;
+        bool stopped_ = false;
+        //|x_|^2 left by the last check for the next normalization, negative when unknown
+        Number x_norm_ = -1;
+        //works only on the buffers allocated in the constructor: x_ and previous_x_ swap their storage
         void OneStep(){
-            previous_x_ = std::move(x_);
-            auto v = Normalized(previous_x_);
-            x_ = A * v;
+            swap(previous_x_, x_);
+            if (x_norm_ >= 0){
+                NormalizeTo(previous_x_, v_, x_norm_);
+                x_norm_ = -1;
+            } else {
+                NormalizeTo(previous_x_, v_);
+            }
             previous_lambda_ = lambda_;
-            auto sigma = v.Transposition() * x_;
-            lambda_ = sigma[0][0];
+            if constexpr (kInverse){
+                InverseStep();
+            } else {
+                auto lambda = GemvDot(A, v_, x_);
+                if constexpr (kAcceleration == Acceleration::Shift){
+                    for (size_t index = 0; index < N_; index++){
+                        x_[index] -= kShift * v_[index];
+                    }
+                }
+                lambda_ = lambda;
+                if constexpr (kAcceleration == Acceleration::Aitken){
+                    lambda_ = Extrapolate(lambda);
+                }
+            }
             count_iteration++;
         }
+        //x_ = (A - shift * E)^-1 v, rescaled so that x_ ~ lambda * v like in the direct modes
+        void InverseStep(){
+            if constexpr (kAcceleration == Acceleration::RayleighQuotient){
+                //the shift follows lambda only once it settled, otherwise the iteration
+                //locks onto whichever eigenvalue the random start is closest to
+                if (count_iteration > 1 && lambda_delta_ <= kRayleighSwitch * std::abs(lambda_ - shift_)){
+                    shift_ = lambda_;
+                    lu_.Factorize(dense_, shift_);
+                }
+            }
+            lu_.Solve(v_, x_);
+            auto mu = Dot(v_, x_);
+            lambda_ = shift_ + 1 / mu;
+            lambda_delta_ = std::abs(lambda_ - previous_lambda_);
+            auto scale = lambda_ / mu;
+            for (size_t index = 0; index < N_; index++){
+                x_[index] *= scale;
+            }
+        }
+        Number Extrapolate(Number lambda){
+            auto [second, first] = raw_lambdas_;
+            raw_lambdas_[0] = first;
+            raw_lambdas_[1] = lambda;
+            auto denominator = lambda - 2 * first + second;
+            if (count_iteration < 2 || denominator == 0){
+                return lambda;
+            }
+            return lambda - (lambda - first) * (lambda - first) / denominator;
+        }
         double CountEpsLambda(){
-            return abs(previous_lambda_ - lambda_);
+            return std::abs(previous_lambda_ - lambda_);
         }
-        double CountEpsVector(){
-            double max = abs(previous_x_[0][0] - x_[0][0]);
-            for (size_t index = 0; index < N_; index++){
-                double temp = abs(previous_x_[index][0] - x_[index][0]);
+        template<typename VectorType>
+        static double CountEpsVector(const VectorType& previous_x, const VectorType& x){
+            double max = std::abs(previous_x[0] - x[0]);
+            for (size_t index = 0; index < x.size(); index++){
+                double temp = std::abs(previous_x[index] - x[index]);
                 if (temp > max) max = temp;
             }
             return max;
         }
-    public:
-        void Solve(){
+        //||x - mu v||, where mu is the quotient that x = A v was scaled by in this step
+        template<typename VectorType>
+        static double CountResidual(const VectorType& x, const VectorType& v, double mu){
+            double sum = 0;
+            for (size_t index = 0; index < x.size(); index++){
+                double diff = x[index] - mu * v[index];
+                sum += diff * diff;
+            }
+            return std::sqrt(sum);
+        }
+        double Quotient(){
+            if constexpr (kAcceleration == Acceleration::Shift){
+                return lambda_ - kShift;
+            } else if constexpr (kAcceleration == Acceleration::Aitken){
+                return raw_lambdas_[1];
+            } else {
+                return lambda_;
+            }
+        }
+        double CountResidual(){
+            return CountResidual(x_, v_, Quotient());
+        }
+        //the eps of kCriterion in one pass over x_ that also keeps |x_|^2 for the next OneStep
+        double CountEpsFused(){
+            Number norm = 0;
+            double eps = 0;
+            if constexpr (kResidual){
+                Number mu = Quotient();
+                for (size_t index = 0; index < N_; index++){
+                    auto value = x_[index];
+                    auto diff = value - mu * v_[index];
+                    norm += value * value;
+                    eps += diff * diff;
+                }
+                eps = std::sqrt(eps);
+            } else {
+                for (size_t index = 0; index < N_; index++){
+                    auto value = x_[index];
+                    norm += value * value;
+                    eps = std::max<double>(eps, std::abs(previous_x_[index] - value));
+                }
+            }
+            x_norm_ = norm;
+            return eps;
+        }
+        //true when the observer asks to stop
+        bool Observe(double eps_lambda, double eps_vector, double residual){
+            if constexpr (kObserved){
+                auto now = Clock::now();
+                IterationRecord record{
+                        count_iteration,
+                        static_cast<double>(lambda_),
+                        eps_lambda,
+                        eps_vector,
+                        residual,
+                        std::chrono::duration<double>(now - step_start_).count()
+                };
+                step_start_ = now;
+                stopped_ = observer_(record) == ObserverAction::Stop;
+                return stopped_;
+            } else {
+                return false;
+            }
+        }
+        //power steps on the float copy, then x_ continues from the float result. Only x decides
+        //the switch: lambda settles long before x and would hand an unconverged x to Number
+        void SolveLowPrecision(){
             double cur_eps_vector;
-            double cur_eps_eigen_lambda;
             do{
+                swap(low_previous_x_, low_x_);
+                NormalizeTo(low_previous_x_, low_v_);
+                previous_lambda_ = lambda_;
+                lambda_ = GemvDot(*low_, low_v_, low_x_);
+                count_iteration++;
+                cur_eps_vector = CountEpsVector(low_previous_x_, low_x_);
+                if constexpr (kObserved){
+                    if (Observe(CountEpsLambda(), cur_eps_vector, CountResidual(low_x_, low_v_, lambda_))){
+                        break;
+                    }
+                }
+            }
+            while (cur_eps_vector > kLowPrecisionSwitch * std::abs(lambda_) && count_iteration < kMaxLowIterations);
+            for (size_t index = 0; index < N_; index++){
+                x_[index] = low_x_[index];
+            }
+        }
+
+    public:
+        void Solve(){
+            NM_LOG_SPAN(Debug, "Solver::Solve");
+            if constexpr (kObserved){
+                stopped_ = false;
+                step_start_ = Clock::now();
+            }
+            if constexpr (kMixed){
+                SolveLowPrecision();
+                NM_LOG(Debug, "float iterations " << count_iteration << " lambda " << lambda_);
+                if (stopped_) return;
+            }
+            x_norm_ = -1;
+            double cur_eps_vector = 0;
+            double cur_eps_eigen_lambda = 0;
+            while (true){
                 OneStep();
-                cur_eps_eigen_lambda = CountEpsLambda();
-                cur_eps_vector = CountEpsVector();
+                bool check = count_iteration % kCheckInterval == 0 || count_iteration >= kMaxCountIterations;
+                if (check){
+                    cur_eps_eigen_lambda = CountEpsLambda();
+                    cur_eps_vector = CountEpsFused();
+                    NM_LOG(Trace, "iteration " << count_iteration << " lambda " << lambda_
+                                               << " eps lambda " << cur_eps_eigen_lambda << " eps x " << cur_eps_vector);
+                }
+                if constexpr (kObserved){
+                    if (!check){
+                        cur_eps_eigen_lambda = CountEpsLambda();
+                        cur_eps_vector = kResidual ? CountResidual() : CountEpsVector(previous_x_, x_);
+                    }
+                    if (Observe(cur_eps_eigen_lambda, cur_eps_vector, CountResidual())) break;
+                }
+                if (check && (
+                        cur_eps_vector <= kEpsEigenVector ||
+                        cur_eps_eigen_lambda <= kEpsEigenLambda ||
+                        count_iteration >= kMaxCountIterations
+                        )){
+                    break;
+                }
             }
-            while (
-                    cur_eps_vector > kEpsEigenVector &&
-                    cur_eps_eigen_lambda > kEpsEigenLambda &&
-                      count_iteration < kMaxCountIterations
-                    );
+            NM_LOG(Debug, "Solver: " << count_iteration << " iterations, lambda " << lambda_);
         }
         //previous_lambda_, lambda_, get_vector_, x_, previous_x_, count_iteration
         decltype(auto) GetAll(){
             return std::tie(previous_lambda_, lambda_, x_, previous_x_, count_iteration);
         }
+        Observer& GetObserver(){
+            return observer_;
+        }
+        //true when the last Solve was ended by the observer
+        bool Stopped() const{
+            return stopped_;
+        }
         Solver(size_t N,
-               Matrix<> matrix,
-               double lambda,
-               Matrix<> get_vector) :
+               Operator matrix,
+               Number lambda,
+               Vector<Number> get_vector) :
+                Solver(N, std::move(matrix), {EigenPair<Number>{lambda, std::move(get_vector)}}) {}
+        //every pair of found is deflated from matrix
+        Solver(size_t N,
+               Operator matrix,
+               std::vector<EigenPair<Number>> found) :
                 N_(N),
-                lambda_(lambda),
-                get_vector_(std::move(get_vector)),
-                x_(N_, 1)
+                A(std::move(matrix)),
+                lambda_(found.empty() ? 0 : found.back().lambda),
+                x_(N_),
+                previous_x_(N_),
+                v_(N_)
         {
             static_assert(kMin < kMax, "минимум должен быть меньше максимума");
+            static_assert(kCheckInterval > 0, "интервал проверки должен быть положительным");
+            static_assert(!kMixed || kAcceleration == Acceleration::None,
+                          "смешанная точность только для обычного степенного метода");
+            static_assert(!kMixed || std::is_same_v<Operator, Matrix<double>>,
+                          "смешанная точность только для плотной матрицы double");
             Distribution distribution_{kMin, kMax};
             std::mt19937 number_generator_{kRandomSeed == RandomSeed::Yes ? std::random_device{}() : 0};
             for (size_t index = 0; index < N_; index++){
-                x_[index][0] = distribution_(number_generator_);
+                x_[index] = distribution_(number_generator_);
+            }
+            if constexpr (kMixed){
+                low_.emplace(Matrix<float>(A.GetOperator().View()));
+                low_x_ = Vector<float>(N_);
+                low_previous_x_ = Vector<float>(N_);
+                low_v_ = Vector<float>(N_);
+                for (size_t index = 0; index < N_; index++){
+                    low_x_[index] = x_[index];
+                }
+                for (auto& [lambda, vector] : found){
+                    Vector<float> low_vector(N_);
+                    for (size_t index = 0; index < N_; index++){
+                        low_vector[index] = vector[index];
+                    }
+                    low_->Deflate({static_cast<float>(lambda), std::move(low_vector)});
+                }
+            }
+            for (auto& pair : found){
+                A.Deflate(std::move(pair));
+            }
+            NM_LOG(Debug, "Solver: N " << N_ << ", deflated pairs " << A.GetPairs().size());
+            if constexpr (kInverse){
+                NM_LOG_SPAN(Debug, "Solver: LU factorization");
+                dense_ = Materialize(A);
+                lu_.Factorize(dense_, shift_);
             }
-            auto temp = lambda_ * get_vector * get_vector.Transposition();
-            Print(temp);
-            A = matrix - temp;
-
         }
     };
 }
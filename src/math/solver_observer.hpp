@@ -0,0 +1,88 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace math {
+    //state of the power method after one step; residual is ||A v - lambda v|| for the normalized
+    //v of the step and seconds is the wall time of the step alone
+    struct IterationRecord {
+        size_t iteration;
+        double lambda;
+        double eps_lambda;
+        double eps_vector;
+        double residual;
+        double seconds;
+    };
+
+    enum struct ObserverAction {
+        Continue, Stop
+    };
+
+    //called by Solver after every step; returning Stop ends Solve early
+    template<typename Observer>
+    concept IsSolverObserver = requires(Observer &observer, const IterationRecord &record) {
+        { observer(record) } -> std::convertible_to<ObserverAction>;
+    };
+
+    //the default: Solver does not even read the clock
+    struct NoObserver {
+        ObserverAction operator()(const IterationRecord &) const {
+            return ObserverAction::Continue;
+        }
+    };
+
+    //keeps the last capacity records in a ring allocated up front, so recording does not allocate.
+    //RequestStop may be called from any thread and ends the run after the current step
+    class ConvergenceRecorder {
+        std::vector<IterationRecord> records_;
+        size_t count_ = 0;
+        std::atomic<bool> stop_{false};
+    public:
+        explicit ConvergenceRecorder(size_t capacity = 1024) : records_(capacity) {
+            if (capacity == 0) throw std::invalid_argument("loh");
+        }
+
+        ConvergenceRecorder(const ConvergenceRecorder &other) :
+                records_(other.records_),
+                count_(other.count_),
+                stop_(other.stop_.load()) {}
+
+        ObserverAction operator()(const IterationRecord &record) {
+            records_[count_ % records_.size()] = record;
+            count_++;
+            return stop_.load(std::memory_order_relaxed) ? ObserverAction::Stop : ObserverAction::Continue;
+        }
+
+        void RequestStop() {
+            stop_.store(true, std::memory_order_relaxed);
+        }
+
+        //number of records seen, including the overwritten ones
+        size_t Count() const {
+            return count_;
+        }
+
+        size_t Capacity() const {
+            return records_.size();
+        }
+
+        //the kept records from the oldest to the newest
+        std::vector<IterationRecord> Records() const {
+            auto kept = std::min(count_, records_.size());
+            std::vector<IterationRecord> result;
+            result.reserve(kept);
+            for (size_t index = count_ - kept; index < count_; index++)
+                result.push_back(records_[index % records_.size()]);
+            return result;
+        }
+
+        void Clear() {
+            count_ = 0;
+            stop_.store(false, std::memory_order_relaxed);
+        }
+    };
+}
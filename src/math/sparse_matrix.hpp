@@ -0,0 +1,116 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "matrix_expression.hpp"
+#include "matrix.hpp"
+#include "vector.hpp"
+#include "gemv.hpp"
+#include "parallel.hpp"
+
+namespace math {
+    template<typename Info = double>
+    struct Triplet {
+        size_t row;
+        size_t column;
+        Info value;
+    };
+
+    //compressed sparse rows: the nonzeros of row i are values_[row_begins_[i]..row_begins_[i + 1])
+    //with sorted columns_; y = A x costs O(nnz) and rows are split between the threads
+    template<typename Info = double>
+    class CsrMatrix : public MatrixExpression<CsrMatrix<Info>> {
+        size_t rows_count_ = 0;
+        size_t columns_count_ = 0;
+        std::vector<size_t> row_begins_;
+        std::vector<size_t> columns_;
+        std::vector<Info> values_;
+    public:
+        using value_type = Info;
+
+        CsrMatrix() = default;
+
+        //entries may come in any order, duplicates are summed
+        CsrMatrix(size_t rows, size_t columns, std::vector<Triplet<Info>> entries) :
+                rows_count_(rows),
+                columns_count_(columns),
+                row_begins_(rows + 1) {
+            for (auto &entry: entries) {
+                if (entry.row >= rows || entry.column >= columns) throw std::invalid_argument("loh");
+            }
+            std::sort(entries.begin(), entries.end(), [](const Triplet<Info> &left, const Triplet<Info> &right) {
+                return left.row != right.row ? left.row < right.row : left.column < right.column;
+            });
+            columns_.reserve(entries.size());
+            values_.reserve(entries.size());
+            for (size_t k = 0; k < entries.size(); k++) {
+                auto &entry = entries[k];
+                if (k > 0 && entries[k - 1].row == entry.row && entries[k - 1].column == entry.column) {
+                    values_.back() += entry.value;
+                    continue;
+                }
+                columns_.push_back(entry.column);
+                values_.push_back(entry.value);
+                row_begins_[entry.row + 1]++;
+            }
+            std::partial_sum(row_begins_.begin(), row_begins_.end(), row_begins_.begin());
+        }
+
+        explicit CsrMatrix(const Matrix<Info> &matrix) :
+                rows_count_(matrix.nRows()),
+                columns_count_(matrix.nColumns()),
+                row_begins_(matrix.nRows() + 1) {
+            for (size_t i = 0; i < rows_count_; i++) {
+                auto row = matrix.RowData(i);
+                for (size_t j = 0; j < columns_count_; j++) {
+                    if (row[j] == Info{}) continue;
+                    columns_.push_back(j);
+                    values_.push_back(row[j]);
+                }
+                row_begins_[i + 1] = values_.size();
+            }
+        }
+
+        size_t nRows() const { return rows_count_; }
+        size_t nColumns() const { return columns_count_; }
+        bool Reads(const void *, const void *) const { return false; }
+        size_t NonZeros() const { return values_.size(); }
+
+        const std::vector<size_t> &RowBegins() const { return row_begins_; }
+        const std::vector<size_t> &Columns() const { return columns_; }
+        const std::vector<Info> &Values() const { return values_; }
+
+        //binary search in the row; for materialization and printing, not for the hot paths
+        Info operator()(size_t i, size_t j) const {
+            auto begin = columns_.begin() + row_begins_[i];
+            auto end = columns_.begin() + row_begins_[i + 1];
+            auto found = std::lower_bound(begin, end, j);
+            return found != end && *found == j ? values_[found - columns_.begin()] : Info{};
+        }
+    };
+
+    //y = A x (SpMV), returns (x, y) over the first min(m, n) elements
+    template<typename T>
+    T GemvDot(const CsrMatrix<T> &matrix, const Vector<T> &x, Vector<T> &y) {
+        if (x.size() != matrix.nColumns() || y.size() != matrix.nRows()) throw std::invalid_argument("loh");
+        auto rows = matrix.nRows();
+        auto row_begins = matrix.RowBegins().data();
+        auto columns = matrix.Columns().data();
+        auto values = matrix.Values().data();
+        auto x_data = x.Data();
+        auto y_data = y.Data();
+        auto row_cost = matrix.NonZeros() / std::max<size_t>(rows, 1) + 1;
+        ParallelRows(rows, row_cost, [&](size_t row_begin, size_t row_end) {
+            for (size_t i = row_begin; i < row_end; i++) {
+                T sum{};
+                for (auto k = row_begins[i]; k < row_begins[i + 1]; k++)
+                    sum += values[k] * x_data[columns[k]];
+                y_data[i] = sum;
+            }
+        });
+        return Dot(std::min(rows, matrix.nColumns()), x_data, y_data);
+    }
+}
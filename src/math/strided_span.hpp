@@ -0,0 +1,77 @@
+#pragma once
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace math {
+    //non-owning view of elements placed with a fixed step:
+    //a matrix row has step 1, a column has step equal to the matrix stride
+    template<typename T>
+    class StridedSpan {
+    public:
+        using value_type = std::remove_cv_t<T>;
+        using reference = T &;
+        using pointer = T *;
+
+        class Iterator {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = std::remove_cv_t<T>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = T *;
+            using reference = T &;
+
+            Iterator() = default;
+            Iterator(T *ptr, difference_type step) : ptr_(ptr), step_(step) {}
+
+            reference operator*() const { return *ptr_; }
+            pointer operator->() const { return ptr_; }
+            reference operator[](difference_type n) const { return ptr_[n * step_]; }
+            Iterator &operator++() { ptr_ += step_; return *this; }
+            Iterator operator++(int) { auto copy = *this; ptr_ += step_; return copy; }
+            Iterator &operator--() { ptr_ -= step_; return *this; }
+            Iterator operator--(int) { auto copy = *this; ptr_ -= step_; return copy; }
+            Iterator &operator+=(difference_type n) { ptr_ += n * step_; return *this; }
+            Iterator &operator-=(difference_type n) { ptr_ -= n * step_; return *this; }
+            friend Iterator operator+(Iterator it, difference_type n) { return it += n; }
+            friend Iterator operator+(difference_type n, Iterator it) { return it += n; }
+            friend Iterator operator-(Iterator it, difference_type n) { return it -= n; }
+            friend difference_type operator-(const Iterator &left, const Iterator &right) {
+                return (left.ptr_ - right.ptr_) / left.step_;
+            }
+            friend auto operator<=>(const Iterator &left, const Iterator &right) {
+                return (left.ptr_ - right.ptr_) * left.step_ <=> 0;
+            }
+            friend bool operator==(const Iterator &left, const Iterator &right) {
+                return left.ptr_ == right.ptr_;
+            }
+        private:
+            T *ptr_ = nullptr;
+            difference_type step_ = 1;
+        };
+
+        StridedSpan() = default;
+        StridedSpan(T *data, size_t size, std::ptrdiff_t step = 1) : data_(data), size_(size), step_(step) {}
+
+        template<typename U>
+        requires std::is_convertible_v<U (*)[], T (*)[]>
+        StridedSpan(const StridedSpan<U> &other) : data_(other.Data()), size_(other.size()), step_(other.Step()) {}
+
+        reference operator[](size_t i) const {
+            return data_[static_cast<std::ptrdiff_t>(i) * step_];
+        }
+
+        size_t size() const { return size_; }
+        std::ptrdiff_t Step() const { return step_; }
+        T *Data() const { return data_; }
+        bool IsContiguous() const { return step_ == 1; }
+
+        Iterator begin() const { return Iterator(data_, step_); }
+        Iterator end() const { return Iterator(data_ + static_cast<std::ptrdiff_t>(size_) * step_, step_); }
+
+    private:
+        T *data_ = nullptr;
+        size_t size_ = 0;
+        std::ptrdiff_t step_ = 1;
+    };
+}
@@ -0,0 +1,147 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "matrix.hpp"
+#include "vector.hpp"
+#include "view.hpp"
+
+namespace math {
+    //eigen decomposition of a small dense symmetric matrix: values are sorted by decreasing
+    //absolute value and the i-th column of vectors belongs to the i-th value
+    template<typename T = double>
+    struct SymmetricEigenDecomposition {
+        Vector<T> values;
+        Matrix<T> vectors;
+    };
+
+    //cyclic Jacobi rotations on a symmetric matrix in place: its diagonal ends up holding the
+    //eigenvalues, unsorted, and every rotation is applied to the columns of rotated, so an identity
+    //gives the eigenvectors in its columns. Nothing is allocated
+    template<typename T>
+    void JacobiEigen(const MatrixView<T> &matrix, const MatrixView<T> &rotated, size_t max_sweeps = 64) {
+        auto n = matrix.nRows();
+        if (n != matrix.nColumns() || rotated.nColumns() != n) throw std::invalid_argument("loh");
+        for (size_t sweep = 0; sweep < max_sweeps; sweep++) {
+            T off = 0;
+            T total = 0;
+            for (size_t i = 0; i < n; i++)
+                for (size_t j = 0; j < n; j++) {
+                    total += matrix(i, j) * matrix(i, j);
+                    if (i != j) off += matrix(i, j) * matrix(i, j);
+                }
+            if (off <= total * std::numeric_limits<T>::epsilon() * std::numeric_limits<T>::epsilon()) break;
+            for (size_t p = 0; p + 1 < n; p++)
+                for (size_t q = p + 1; q < n; q++) {
+                    auto apq = matrix(p, q);
+                    if (apq == 0) continue;
+                    auto theta = (matrix(q, q) - matrix(p, p)) / (2 * apq);
+                    auto t = (theta >= 0 ? 1 : -1) / (std::abs(theta) + std::sqrt(theta * theta + 1));
+                    auto c = 1 / std::sqrt(t * t + 1);
+                    auto s = t * c;
+                    for (size_t k = 0; k < n; k++) {
+                        auto akp = matrix(k, p);
+                        auto akq = matrix(k, q);
+                        matrix(k, p) = c * akp - s * akq;
+                        matrix(k, q) = s * akp + c * akq;
+                    }
+                    for (size_t k = 0; k < n; k++) {
+                        auto apk = matrix(p, k);
+                        auto aqk = matrix(q, k);
+                        matrix(p, k) = c * apk - s * aqk;
+                        matrix(q, k) = s * apk + c * aqk;
+                    }
+                    for (size_t k = 0; k < rotated.nRows(); k++) {
+                        auto vkp = rotated(k, p);
+                        auto vkq = rotated(k, q);
+                        rotated(k, p) = c * vkp - s * vkq;
+                        rotated(k, q) = s * vkp + c * vkq;
+                    }
+                }
+        }
+    }
+
+    //meant for the k x k matrices of Rayleigh-Ritz and Lanczos steps
+    template<typename T>
+    SymmetricEigenDecomposition<T> SymmetricEigen(Matrix<T> matrix, size_t max_sweeps = 64) {
+        auto n = matrix.nRows();
+        if (n != matrix.nColumns()) throw std::invalid_argument("loh");
+        auto vectors = MakeIdentityMatrix<T>(n);
+        JacobiEigen(matrix.View(), vectors.View(), max_sweeps);
+        std::vector<size_t> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](size_t left, size_t right) {
+            return std::abs(matrix[left][left]) > std::abs(matrix[right][right]);
+        });
+        SymmetricEigenDecomposition<T> result{Vector<T>(n), Matrix<T>(n, n)};
+        for (size_t i = 0; i < n; i++) {
+            result.values[i] = matrix[order[i]][order[i]];
+            for (size_t k = 0; k < n; k++)
+                result.vectors[k][i] = vectors[k][order[i]];
+        }
+        return result;
+    }
+
+    //implicit QL with Wilkinson shifts for the symmetric tridiagonal matrix with the diagonal
+    //diagonal[0..n) and off_diagonal[i] between i and i + 1; both are overwritten and diagonal
+    //ends up holding the eigenvalues, unsorted. Every rotation is applied to the columns of
+    //rotated, so an identity gives the eigenvectors in its columns and the last row of the
+    //identity alone gives their last components in O(n) per rotation. Nothing is allocated
+    template<typename T>
+    void TridiagonalEigen(T *diagonal, T *off_diagonal, size_t n, MatrixView<T> rotated, size_t max_iterations = 64) {
+        if (rotated.nColumns() != n) throw std::invalid_argument("loh");
+        if (n == 0) return;
+        off_diagonal[n - 1] = 0;
+        for (size_t l = 0; l < n; l++) {
+            size_t iteration = 0;
+            size_t m;
+            do {
+                for (m = l; m + 1 < n; m++) {
+                    auto scale = std::abs(diagonal[m]) + std::abs(diagonal[m + 1]);
+                    if (std::abs(off_diagonal[m]) <= std::numeric_limits<T>::epsilon() * scale) break;
+                }
+                if (m == l || iteration++ == max_iterations) break;
+                auto g = (diagonal[l + 1] - diagonal[l]) / (2 * off_diagonal[l]);
+                auto r = std::hypot(g, T{1});
+                g = diagonal[m] - diagonal[l] + off_diagonal[l] / (g + std::copysign(r, g));
+                T s = 1;
+                T c = 1;
+                T p = 0;
+                bool underflow = false;
+                for (auto i = static_cast<std::ptrdiff_t>(m) - 1; i >= static_cast<std::ptrdiff_t>(l); i--) {
+                    auto f = s * off_diagonal[i];
+                    auto b = c * off_diagonal[i];
+                    r = std::hypot(f, g);
+                    off_diagonal[i + 1] = r;
+                    if (r == 0) {
+                        diagonal[i + 1] -= p;
+                        off_diagonal[m] = 0;
+                        underflow = true;
+                        break;
+                    }
+                    s = f / r;
+                    c = g / r;
+                    g = diagonal[i + 1] - p;
+                    r = (diagonal[i] - g) * s + 2 * c * b;
+                    p = s * r;
+                    diagonal[i + 1] = g + p;
+                    g = c * r - b;
+                    for (size_t k = 0; k < rotated.nRows(); k++) {
+                        auto next = rotated(k, i + 1);
+                        rotated(k, i + 1) = s * rotated(k, i) + c * next;
+                        rotated(k, i) = c * rotated(k, i) - s * next;
+                    }
+                }
+                if (underflow) continue;
+                diagonal[l] -= p;
+                off_diagonal[l] = g;
+                off_diagonal[m] = 0;
+            } while (true);
+        }
+    }
+}
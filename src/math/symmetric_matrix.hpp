@@ -0,0 +1,124 @@
+#pragma once
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "aligned_allocator.hpp"
+#include "matrix_expression.hpp"
+#include "matrix.hpp"
+#include "vector.hpp"
+#include "gemv.hpp"
+#include "parallel.hpp"
+
+namespace math {
+    //symmetric n x n matrix that keeps only the upper triangle, packed row by row:
+    //row i holds the columns i..n-1 contiguously, so a mat-vec streams n(n+1)/2 elements once
+    template<typename Info = double>
+    class SymmetricMatrix : public MatrixExpression<SymmetricMatrix<Info>> {
+        size_t size_ = 0;
+        std::vector<Info, AlignedAllocator<Info>> m_cells;
+
+        size_t Offset(size_t i) const {
+            return i * size_ - i * (i - 1) / 2;
+        }
+    public:
+        using value_type = Info;
+
+        SymmetricMatrix() = default;
+        explicit SymmetricMatrix(size_t size) : size_(size), m_cells(size * (size + 1) / 2) {}
+
+        //takes the upper triangle of any square matrix or expression
+        template<typename Expression>
+        requires std::is_convertible_v<typename Expression::value_type, Info>
+        explicit SymmetricMatrix(const MatrixExpression<Expression> &expression) :
+                SymmetricMatrix(expression.Self().nRows()) {
+            auto &self = expression.Self();
+            if (self.nRows() != self.nColumns()) throw std::invalid_argument("loh");
+            ParallelRows(size_, size_ / 2 + 1, [&](size_t row_begin, size_t row_end) {
+                for (size_t i = row_begin; i < row_end; i++) {
+                    auto row = RowData(i);
+                    for (size_t j = i; j < size_; j++)
+                        row[j - i] = self(i, j);
+                }
+            });
+        }
+
+        explicit SymmetricMatrix(const Matrix<Info> &matrix) : SymmetricMatrix(matrix.nRows()) {
+            if (matrix.nRows() != matrix.nColumns()) throw std::invalid_argument("loh");
+            for (size_t i = 0; i < size_; i++)
+                std::copy(matrix.RowData(i) + i, matrix.RowData(i) + size_, RowData(i));
+        }
+
+        size_t nRows() const { return size_; }
+        size_t nColumns() const { return size_; }
+        bool Reads(const void *, const void *) const { return false; }
+
+        Info *Data() { return m_cells.data(); }
+        const Info *Data() const { return m_cells.data(); }
+
+        //the packed row i: n - i elements a_ii..a_i,n-1
+        Info *RowData(size_t i) { return m_cells.data() + Offset(i); }
+        const Info *RowData(size_t i) const { return m_cells.data() + Offset(i); }
+
+        Info &operator()(size_t i, size_t j) {
+            if (i > j) std::swap(i, j);
+            return RowData(i)[j - i];
+        }
+
+        Info operator()(size_t i, size_t j) const {
+            if (i > j) std::swap(i, j);
+            return RowData(i)[j - i];
+        }
+
+        //A += alpha * x * x^T
+        void RankOneUpdate(Info alpha, const Vector<Info> &x) {
+            if (x.size() != size_) throw std::invalid_argument("loh");
+            ParallelRows(size_, size_ / 2 + 1, [&](size_t row_begin, size_t row_end) {
+                for (size_t i = row_begin; i < row_end; i++) {
+                    auto row = RowData(i);
+                    auto scale = alpha * x[i];
+                    for (size_t j = i; j < size_; j++)
+                        row[j - i] += scale * x[j];
+                }
+            });
+        }
+
+        //A = alpha * X * X^T + beta * A for the n x k matrix X (SYRK); only the upper triangle is computed
+        void RankKUpdate(Info alpha, MatrixView<const Info> x, Info beta = Info{1}) {
+            if (x.nRows() != size_) throw std::invalid_argument("loh");
+            auto k = x.nColumns();
+            ParallelRows(size_, (size_ / 2 + 1) * k, [&](size_t row_begin, size_t row_end) {
+                for (size_t i = row_begin; i < row_end; i++) {
+                    auto row = RowData(i);
+                    for (size_t j = i; j < size_; j++)
+                        row[j - i] = beta * row[j - i] + alpha * Dot(x.Row(i), x.Row(j));
+                }
+            });
+        }
+    };
+
+    //y = A x (SYMV) over the packed upper triangle, returns (x, y): the row i contributes
+    //a dot product to y_i and, through symmetry, an axpy to y_i+1..y_n-1
+    template<typename T>
+    T GemvDot(const SymmetricMatrix<T> &matrix, const Vector<T> &x, Vector<T> &y) {
+        auto n = matrix.nRows();
+        if (x.size() != n || y.size() != n) throw std::invalid_argument("loh");
+        for (size_t i = 0; i < n; i++)
+            y[i] = T{};
+        auto x_data = x.Data();
+        auto y_data = y.Data();
+        T dot{};
+        for (size_t i = 0; i < n; i++) {
+            auto row = matrix.RowData(i);
+            auto value = x_data[i];
+            auto tail = n - i - 1;
+            auto sum = y_data[i] + row[0] * value + Dot(tail, row + 1, x_data + i + 1);
+            for (size_t j = 0; j < tail; j++)
+                y_data[i + 1 + j] += row[1 + j] * value;
+            y_data[i] = sum;
+            dot += value * sum;
+        }
+        return dot;
+    }
+}
@@ -0,0 +1,258 @@
+#pragma once
+#include <vector>
+#include <iostream>
+#include <stdexcept>
+#include <initializer_list>
+#include <type_traits>
+#include <cmath>
+#include <utility>
+#include "aligned_allocator.hpp"
+#include "matrix.hpp"
+#include "gemv.hpp"
+#include "parallel.hpp"
+
+namespace math {
+    template<typename T>
+    concept IsScalar = std::is_arithmetic_v<T>;
+
+    //dense column vector; replaces N x 1 matrices in the mat-vec paths.
+    //Allocator plays the same role as in Matrix
+    template<typename Info = double, typename Allocator = AlignedAllocator<Info>>
+    class Vector {
+    private:
+        std::vector<Info, Allocator> m_cells;
+
+    public:
+        Vector() = default;
+        explicit Vector(size_t size) : m_cells(size) {}
+        Vector(std::initializer_list<Info> list) : m_cells(list) {}
+        explicit Vector(const StridedSpan<const Info> &span) : m_cells(span.begin(), span.end()) {}
+
+        size_t size() const {
+            return m_cells.size();
+        }
+
+        Info *Data() {
+            return m_cells.data();
+        }
+
+        const Info *Data() const {
+            return m_cells.data();
+        }
+
+        StridedSpan<Info> View() {
+            return StridedSpan<Info>(Data(), size());
+        }
+
+        StridedSpan<const Info> View() const {
+            return StridedSpan<const Info>(Data(), size());
+        }
+
+        Info &operator[](size_t i) {
+            return m_cells[i];
+        }
+
+        const Info &operator[](size_t i) const {
+            return m_cells[i];
+        }
+
+        auto begin() { return m_cells.begin(); }
+        auto end() { return m_cells.end(); }
+        auto begin() const { return m_cells.begin(); }
+        auto end() const { return m_cells.end(); }
+
+        friend void swap(Vector &left, Vector &right) noexcept {
+            left.m_cells.swap(right.m_cells);
+        }
+
+        friend bool operator==(const Vector &left, const Vector &right) {
+            return left.m_cells == right.m_cells;
+        }
+
+        friend std::ostream &operator<<(std::ostream &out, const Vector &vector) {
+            for (auto &elem: vector.m_cells)
+                out << elem << "\t\n";
+            return out;
+        }
+    };
+
+    template<typename LCell, typename LAllocator, typename RCell, typename RAllocator>
+    requires math::IsSummable<LCell, RCell>
+    auto operator+(const Vector<LCell, LAllocator> &left, const Vector<RCell, RAllocator> &right) {
+        if (left.size() != right.size()) throw std::invalid_argument("loh");
+        using Result = decltype(std::declval<LCell>() + std::declval<RCell>());
+        Vector<Result, RebindAllocator<LAllocator, Result>> res(left.size());
+        for (size_t i = 0; i < res.size(); i++)
+            res[i] = left[i] + right[i];
+        return res;
+    }
+
+    template<typename LCell, typename LAllocator, typename RCell, typename RAllocator>
+    requires math::IsDeductible<LCell, RCell>
+    auto operator-(const Vector<LCell, LAllocator> &left, const Vector<RCell, RAllocator> &right) {
+        if (left.size() != right.size()) throw std::invalid_argument("loh");
+        using Result = decltype(std::declval<LCell>() - std::declval<RCell>());
+        Vector<Result, RebindAllocator<LAllocator, Result>> res(left.size());
+        for (size_t i = 0; i < res.size(); i++)
+            res[i] = left[i] - right[i];
+        return res;
+    }
+
+    template<typename Cell, typename Allocator, IsScalar Right>
+    auto operator*(const Vector<Cell, Allocator> &left, const Right &right) {
+        using Result = decltype(std::declval<Cell>() * std::declval<Right>());
+        Vector<Result, RebindAllocator<Allocator, Result>> res(left.size());
+        for (size_t i = 0; i < res.size(); i++)
+            res[i] = left[i] * right;
+        return res;
+    }
+
+    template<IsScalar Left, typename Cell, typename Allocator>
+    auto operator*(const Left &left, const Vector<Cell, Allocator> &right) {
+        return right * left;
+    }
+
+    template<typename Cell, typename Allocator, IsScalar Denominator>
+    auto operator/(const Vector<Cell, Allocator> &left, const Denominator &denominator) {
+        using Result = decltype(std::declval<Cell>() / std::declval<Denominator>());
+        Vector<Result, RebindAllocator<Allocator, Result>> res(left.size());
+        for (size_t i = 0; i < res.size(); i++)
+            res[i] = left[i] / denominator;
+        return res;
+    }
+
+    template<typename LCell, typename LAllocator, typename RCell, typename RAllocator>
+    requires math::IsSummable<LCell, RCell>
+    Vector<LCell, LAllocator> &operator+=(Vector<LCell, LAllocator> &left, const Vector<RCell, RAllocator> &right) {
+        if (left.size() != right.size()) throw std::invalid_argument("loh");
+        for (size_t i = 0; i < left.size(); i++)
+            left[i] += right[i];
+        return left;
+    }
+
+    template<typename LCell, typename LAllocator, typename RCell, typename RAllocator>
+    requires math::IsDeductible<LCell, RCell>
+    Vector<LCell, LAllocator> &operator-=(Vector<LCell, LAllocator> &left, const Vector<RCell, RAllocator> &right) {
+        if (left.size() != right.size()) throw std::invalid_argument("loh");
+        for (size_t i = 0; i < left.size(); i++)
+            left[i] -= right[i];
+        return left;
+    }
+
+    template<typename Cell, typename Allocator, IsScalar Right>
+    Vector<Cell, Allocator> &operator*=(Vector<Cell, Allocator> &left, const Right &right) {
+        for (size_t i = 0; i < left.size(); i++)
+            left[i] *= right;
+        return left;
+    }
+
+    template<typename Cell, typename Allocator, IsScalar Denominator>
+    Vector<Cell, Allocator> &operator/=(Vector<Cell, Allocator> &left, const Denominator &denominator) {
+        for (size_t i = 0; i < left.size(); i++)
+            left[i] /= denominator;
+        return left;
+    }
+
+    //a temporary operand gives its buffer to the result when the cell type does not change
+    template<typename Cell, typename Allocator, typename RCell, typename RAllocator>
+    requires std::is_same_v<decltype(std::declval<Cell>() + std::declval<RCell>()), Cell>
+    Vector<Cell, Allocator> operator+(Vector<Cell, Allocator> &&left, const Vector<RCell, RAllocator> &right) {
+        left += right;
+        return std::move(left);
+    }
+
+    template<typename LCell, typename LAllocator, typename Cell, typename Allocator>
+    requires std::is_same_v<decltype(std::declval<LCell>() + std::declval<Cell>()), Cell>
+    Vector<Cell, Allocator> operator+(const Vector<LCell, LAllocator> &left, Vector<Cell, Allocator> &&right) {
+        right += left;
+        return std::move(right);
+    }
+
+    template<typename Cell, typename Allocator, typename RCell, typename RAllocator>
+    requires std::is_same_v<decltype(std::declval<Cell>() + std::declval<RCell>()), Cell>
+    Vector<Cell, Allocator> operator+(Vector<Cell, Allocator> &&left, Vector<RCell, RAllocator> &&right) {
+        left += right;
+        return std::move(left);
+    }
+
+    template<typename Cell, typename Allocator, typename RCell, typename RAllocator>
+    requires std::is_same_v<decltype(std::declval<Cell>() - std::declval<RCell>()), Cell>
+    Vector<Cell, Allocator> operator-(Vector<Cell, Allocator> &&left, const Vector<RCell, RAllocator> &right) {
+        left -= right;
+        return std::move(left);
+    }
+
+    template<typename LCell, typename LAllocator, typename Cell, typename Allocator>
+    requires std::is_same_v<decltype(std::declval<LCell>() - std::declval<Cell>()), Cell>
+    Vector<Cell, Allocator> operator-(const Vector<LCell, LAllocator> &left, Vector<Cell, Allocator> &&right) {
+        if (left.size() != right.size()) throw std::invalid_argument("loh");
+        for (size_t i = 0; i < right.size(); i++)
+            right[i] = left[i] - right[i];
+        return std::move(right);
+    }
+
+    template<typename Cell, typename Allocator, typename RCell, typename RAllocator>
+    requires std::is_same_v<decltype(std::declval<Cell>() - std::declval<RCell>()), Cell>
+    Vector<Cell, Allocator> operator-(Vector<Cell, Allocator> &&left, Vector<RCell, RAllocator> &&right) {
+        left -= right;
+        return std::move(left);
+    }
+
+    template<typename Cell, typename Allocator, IsScalar Right>
+    requires std::is_same_v<decltype(std::declval<Cell>() * std::declval<Right>()), Cell>
+    Vector<Cell, Allocator> operator*(Vector<Cell, Allocator> &&left, const Right &right) {
+        left *= right;
+        return std::move(left);
+    }
+
+    template<IsScalar Left, typename Cell, typename Allocator>
+    requires std::is_same_v<decltype(std::declval<Left>() * std::declval<Cell>()), Cell>
+    Vector<Cell, Allocator> operator*(const Left &left, Vector<Cell, Allocator> &&right) {
+        for (size_t i = 0; i < right.size(); i++)
+            right[i] = left * right[i];
+        return std::move(right);
+    }
+
+    template<typename Cell, typename Allocator, IsScalar Denominator>
+    requires std::is_same_v<decltype(std::declval<Cell>() / std::declval<Denominator>()), Cell>
+    Vector<Cell, Allocator> operator/(Vector<Cell, Allocator> &&left, const Denominator &denominator) {
+        left /= denominator;
+        return std::move(left);
+    }
+
+    //result = vector / |vector| when |vector|^2 is already known, a single pass
+    template<typename T, typename Allocator, typename RAllocator>
+    void NormalizeTo(const Vector<T, Allocator> &vector, Vector<T, RAllocator> &result, T squared_norm) {
+        if (vector.size() != result.size()) throw std::invalid_argument("loh");
+        auto norm = std::sqrt(squared_norm);
+        for (size_t i = 0; i < vector.size(); i++)
+            result[i] = vector[i] / norm;
+    }
+
+    //result = vector / |vector| without allocating; result must already have the size of vector
+    template<typename T, typename Allocator, typename RAllocator>
+    void NormalizeTo(const Vector<T, Allocator> &vector, Vector<T, RAllocator> &result) {
+        NormalizeTo(vector, result, Dot(vector.size(), vector.Data(), vector.Data()));
+    }
+
+    template<typename T, typename LAllocator, typename RAllocator>
+    T Dot(const Vector<T, LAllocator> &left, const Vector<T, RAllocator> &right) {
+        if (left.size() != right.size()) throw std::invalid_argument("loh");
+        return Dot(left.size(), left.Data(), right.Data());
+    }
+
+    //result = matrix * vector; returns (vector, result)
+    template<typename T, typename Allocator, typename VAllocator>
+    T GemvDot(const Matrix<T, Allocator> &matrix, const Vector<T, VAllocator> &vector, Vector<T, VAllocator> &result) {
+        if (matrix.nColumns() != vector.size() || matrix.nRows() != result.size())
+            throw std::invalid_argument("loh");
+        return GemvDot(matrix.View(), vector.View(), result.View());
+    }
+
+    template<typename T, typename Allocator, typename VAllocator>
+    Vector<T, VAllocator> operator*(const Matrix<T, Allocator> &matrix, const Vector<T, VAllocator> &vector) {
+        Vector<T, VAllocator> result(matrix.nRows());
+        GemvDot(matrix, vector, result);
+        return result;
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include "strided_span.hpp"
+#include "matrix_expression.hpp"
+
+namespace math {
+    //non-owning matrix view with independent row and column strides:
+    //transposition, rows, columns and blocks of a matrix are views over the same cells
+    template<typename T>
+    class MatrixView : public MatrixExpression<MatrixView<T>> {
+        T *data_ = nullptr;
+        size_t rows_count_ = 0;
+        size_t columns_count_ = 0;
+        std::ptrdiff_t row_stride_ = 0;
+        std::ptrdiff_t column_stride_ = 1;
+
+    public:
+        using value_type = std::remove_const_t<T>;
+
+        MatrixView() = default;
+        MatrixView(T *data, size_t rows, size_t columns, std::ptrdiff_t row_stride, std::ptrdiff_t column_stride = 1) :
+                data_(data),
+                rows_count_(rows),
+                columns_count_(columns),
+                row_stride_(row_stride),
+                column_stride_(column_stride) {}
+
+        template<typename U>
+        requires std::is_convertible_v<U (*)[], T (*)[]>
+        MatrixView(const MatrixView<U> &other) :
+                MatrixView(other.Data(), other.nRows(), other.nColumns(), other.RowStride(), other.ColumnStride()) {}
+
+        size_t nRows() const { return rows_count_; }
+        size_t nColumns() const { return columns_count_; }
+        std::ptrdiff_t RowStride() const { return row_stride_; }
+        std::ptrdiff_t ColumnStride() const { return column_stride_; }
+        T *Data() const { return data_; }
+
+        //rows are contiguous, so the view can be passed to the row-major kernels
+        bool IsRowMajor() const { return column_stride_ == 1; }
+
+        bool Reads(const void *begin, const void *end) const {
+            if (rows_count_ == 0 || columns_count_ == 0) return false;
+            auto row_offset = static_cast<std::ptrdiff_t>(rows_count_ - 1) * row_stride_;
+            auto column_offset = static_cast<std::ptrdiff_t>(columns_count_ - 1) * column_stride_;
+            auto low = std::min<std::ptrdiff_t>(row_offset, 0) + std::min<std::ptrdiff_t>(column_offset, 0);
+            auto high = std::max<std::ptrdiff_t>(row_offset, 0) + std::max<std::ptrdiff_t>(column_offset, 0);
+            return Overlaps(data_ + low, data_ + high, begin, end);
+        }
+
+        T &operator()(size_t i, size_t j) const {
+            return data_[static_cast<std::ptrdiff_t>(i) * row_stride_ + static_cast<std::ptrdiff_t>(j) * column_stride_];
+        }
+
+        StridedSpan<T> operator[](size_t i) const {
+            return Row(i);
+        }
+
+        StridedSpan<T> Row(size_t i) const {
+            return StridedSpan<T>(data_ + static_cast<std::ptrdiff_t>(i) * row_stride_, columns_count_, column_stride_);
+        }
+
+        StridedSpan<T> Column(size_t j) const {
+            return StridedSpan<T>(data_ + static_cast<std::ptrdiff_t>(j) * column_stride_, rows_count_, row_stride_);
+        }
+
+        MatrixView Transposed() const {
+            return MatrixView(data_, columns_count_, rows_count_, column_stride_, row_stride_);
+        }
+
+        MatrixView Block(size_t row, size_t column, size_t rows, size_t columns) const {
+            return MatrixView(&(*this)(row, column), rows, columns, row_stride_, column_stride_);
+        }
+    };
+}
@@ -8,7 +8,16 @@
 #include <random>
 #include <array>
 #include <functional>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <tuple>
 #include "math/matrix.hpp"
+#include "math/vector.hpp"
+#include "math/expression.hpp"
+#include "math/householder.hpp"
+#include "math/fixed_matrix.hpp"
+#include "log.hpp"
 
 namespace utils {
     template<typename Number>
@@ -25,48 +34,57 @@ namespace utils {
     template<typename Number,
             Traits<Number> traits,
             RandomSeed kRandomSeed = RandomSeed::No,
-            typename Distribution = std::uniform_real_distribution<Number>>
+            typename Distribution = std::uniform_real_distribution<Number>,
+            typename Allocator = math::AlignedAllocator<double>>
     class Generator final {
     public:
         static constexpr inline auto kSize = traits.kSize;
         static constexpr inline auto kMin = traits.kMin;
         static constexpr inline auto kMax = traits.kMax;
+        static constexpr inline double kEps = 0.0001;
+        static constexpr inline double kMaxAbs = -kMin < kMax ? kMax : -kMin;
+        //small sizes are kept on the stack, the rest in the storage of Allocator
+        using Matrix = math::MatrixFor<double, kSize, kSize, Allocator>;
+        using Vector = math::VectorFor<double, kSize, math::RebindAllocator<Allocator, double>>;
     protected:
         void GenerateVector() {
-            vector_ = math::Matrix<>(kSize, 1);
+            vector_ = Vector(kSize);
             for (size_t i = 0; i < kSize; i++){
-                vector_[i][0] = GenerateNumber();
+                vector_[i] = GenerateNumber();
             }
-            vector_ = math::Normalized(vector_);
+            math::NormalizeTo(vector_, vector_);
         }
         void GenerateHouseHolderMatrix(){
-            auto E = math::MakeIdentityMatrix<>(kSize);
-            auto F = 2 * vector_ * vector_.Transposition();
-            Print(F);
-            house_holder_matrix_ = E - 2 * vector_ * vector_.Transposition();
+            house_holder_ = math::HouseholderReflection<double, Vector>(vector_);
+            house_holder_matrix_ = house_holder_;
         }
         void GenerateDiagonalMatrix(){
-            diagonal_matrix_ = math::Matrix<>{kSize};
-            double eps = 0.0001;
-
+            //magnitudes have to grow along the diagonal by at least eps: sorted samples are squeezed
+            //and shifted by i * eps, which keeps the gaps without redrawing numbers
+            math::VectorFor<Number, kSize, math::RebindAllocator<Allocator, Number>> numbers(kSize);
+            for (auto& number : numbers){
+                number = GenerateNumber();
+            }
+            std::sort(numbers.begin(), numbers.end(), [](Number left, Number right){
+                return std::abs(left) < std::abs(right);
+            });
+            auto shrink = 1 - kSize * kEps / kMaxAbs;
+            Vector diagonal(kSize);
             for (size_t i = 0; i < kSize; i++){
-                auto number = GenerateNumber();
-                for (size_t j = i + 1; j > 0; j--){
-                    while (abs(number) - abs(diagonal_matrix_[j - 1][j - 1]) < eps){
-                        number = GenerateNumber();
-                    }
-                }
-                diagonal_matrix_[i][i] = number;
+                auto magnitude = std::abs(numbers[i]) * shrink + (i + 1) * kEps;
+                diagonal[i] = numbers[i] < 0 ? -magnitude : magnitude;
             }
+            diagonal_ = math::DiagonalMatrix<double, Vector>(std::move(diagonal));
+            diagonal_matrix_ = diagonal_;
         }
         void GenerateResultMatrix(){
-            Print(house_holder_matrix_);
-            Print(diagonal_matrix_);
-            Print(house_holder_matrix_.Transposition());
-            auto left =  house_holder_matrix_ * diagonal_matrix_;
-            Print(left);
-            result_matrix_ = left * house_holder_matrix_.Transposition();
-            Print(result_matrix_);
+            NM_LOG_SPAN(Debug, "Generator::GenerateResultMatrix");
+            NM_LOG(Trace, "house_holder_matrix_\n" << house_holder_matrix_);
+            NM_LOG(Trace, "diagonal_matrix_\n" << diagonal_matrix_);
+            result_ = math::ReflectedDiagonal<double, Vector>(house_holder_, diagonal_);
+            result_matrix_ = result_;
+            NM_LOG(Trace, "result_matrix_\n" << result_matrix_);
+            NM_LOG(Debug, "result_matrix_ " << utils::Summary(result_matrix_));
         }
         Number GenerateNumber() {
             Number number = distribution_(number_generator_);
@@ -78,6 +96,7 @@ namespace utils {
     public:
         Generator() {
             static_assert(kMin < kMax, "минимум должен быть меньше максимума");
+            static_assert(kSize * kEps < kMaxAbs, "собственные числа не помещаются в диапазон с шагом kEps");
         }
         void GenerateAll(){
             GenerateVector();
@@ -89,11 +108,18 @@ namespace utils {
         decltype(auto) GetAll() const {
             return std::tie(vector_, house_holder_matrix_, diagonal_matrix_, result_matrix_);
         }
+        //the same matrices as structured operators: Householder reflection, diagonal, H * D * H^T
+        decltype(auto) GetOperators() const {
+            return std::tie(house_holder_, diagonal_, result_);
+        }
     private:
-        math::Matrix<> vector_;
-        math::Matrix<> house_holder_matrix_;
-        math::Matrix<> diagonal_matrix_;
-        math::Matrix<> result_matrix_;
+        math::HouseholderReflection<double, Vector> house_holder_;
+        math::DiagonalMatrix<double, Vector> diagonal_;
+        math::ReflectedDiagonal<double, Vector> result_;
+        Vector vector_;
+        Matrix house_holder_matrix_;
+        Matrix diagonal_matrix_;
+        Matrix result_matrix_;
         Distribution distribution_{kMin, kMax};
         std::mt19937 number_generator_{kRandomSeed == RandomSeed::Yes ? std::random_device{}() : 0};
     };
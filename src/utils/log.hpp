@@ -0,0 +1,113 @@
+#ifndef NUMERIC_METHODS3_UTILS_LOG
+#define NUMERIC_METHODS3_UTILS_LOG
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <string_view>
+
+//the smallest level that is compiled in: 0 trace, 1 debug, 2 info, 3 warning, 4 error, 5 nothing.
+//Release builds (NDEBUG) compile every message out, so the hot paths do no formatting and no I/O
+#ifndef NUMERIC_METHODS_LOG_LEVEL
+#ifdef NDEBUG
+#define NUMERIC_METHODS_LOG_LEVEL 5
+#else
+#define NUMERIC_METHODS_LOG_LEVEL 2
+#endif
+#endif
+
+namespace utils {
+    enum struct LogLevel{
+        Trace, Debug, Info, Warning, Error, Off
+    };
+
+    inline constexpr auto kLogLevel = static_cast<LogLevel>(NUMERIC_METHODS_LOG_LEVEL);
+
+    constexpr bool IsLogEnabled(LogLevel level){
+        return level >= kLogLevel && level != LogLevel::Off;
+    }
+
+    inline std::ostream*& LogStreamStorage(){
+        static std::ostream* stream = &std::clog;
+        return stream;
+    }
+
+    //where the messages go, std::clog by default
+    inline void SetLogStream(std::ostream& stream){
+        LogStreamStorage() = &stream;
+    }
+
+    inline std::ostream& LogStream(LogLevel level){
+        constexpr std::string_view kNames[] = {"trace", "debug", "info", "warning", "error"};
+        return *LogStreamStorage() << '[' << kNames[static_cast<size_t>(level)] << "] ";
+    }
+
+    //dimensions and norms instead of the cells: cheap to print for any size
+    template<typename Matrix>
+    struct MatrixSummary{
+        const Matrix& matrix;
+
+        friend std::ostream& operator<<(std::ostream& out, const MatrixSummary& summary){
+            auto& matrix = summary.matrix;
+            double frobenius = 0;
+            double max = 0;
+            for (size_t i = 0; i < matrix.nRows(); i++){
+                for (size_t j = 0; j < matrix.nColumns(); j++){
+                    double value = std::abs(matrix[i][j]);
+                    frobenius += value * value;
+                    if (value > max) max = value;
+                }
+            }
+            return out << matrix.nRows() << 'x' << matrix.nColumns()
+                       << " frobenius=" << std::sqrt(frobenius) << " max=" << max;
+        }
+    };
+
+    template<typename Matrix>
+    MatrixSummary<Matrix> Summary(const Matrix& matrix){
+        return {matrix};
+    }
+
+    //logs the time between construction and destruction
+    template<LogLevel level, bool = IsLogEnabled(level)>
+    class TimingSpan{
+        using Clock = std::chrono::steady_clock;
+        std::string_view name_;
+        Clock::time_point start_;
+    public:
+        explicit TimingSpan(std::string_view name) : name_(name), start_(Clock::now()){}
+        TimingSpan(const TimingSpan&) = delete;
+        TimingSpan& operator=(const TimingSpan&) = delete;
+        ~TimingSpan(){
+            std::chrono::duration<double, std::milli> elapsed = Clock::now() - start_;
+            LogStream(level) << name_ << ": " << elapsed.count() << " ms\n";
+        }
+    };
+
+    //the level is compiled out: an empty object that neither reads the clock nor stores anything
+    template<LogLevel level>
+    class TimingSpan<level, false>{
+    public:
+        explicit TimingSpan(std::string_view){}
+        TimingSpan(const TimingSpan&) = delete;
+        TimingSpan& operator=(const TimingSpan&) = delete;
+    };
+}
+
+//the message is an operator<< chain that is evaluated only when the level is compiled in:
+//NM_LOG(Debug, "lambda " << lambda_);
+#define NM_LOG(level, message) \
+    do { \
+        if constexpr (utils::IsLogEnabled(utils::LogLevel::level)) { \
+            utils::LogStream(utils::LogLevel::level) << message << '\n'; \
+        } \
+    } while (false)
+
+#define NM_LOG_CONCAT_IMPL(left, right) left##right
+#define NM_LOG_CONCAT(left, right) NM_LOG_CONCAT_IMPL(left, right)
+
+//times the rest of the enclosing scope
+#define NM_LOG_SPAN(level, name) \
+    utils::TimingSpan<utils::LogLevel::level> NM_LOG_CONCAT(log_span_, __LINE__){name}
+
+#endif
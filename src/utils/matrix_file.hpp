@@ -0,0 +1,298 @@
+#ifndef NUMERIC_METHODS3_UTILS_MATRIX_FILE
+#define NUMERIC_METHODS3_UTILS_MATRIX_FILE
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "math/matrix.hpp"
+#include "math/symmetric_matrix.hpp"
+#include "math/view.hpp"
+
+namespace utils {
+    //binary matrix file: a 64 byte header followed by the cells in row-major order, or by the
+    //packed upper triangle of SymmetricMatrix when kMatrixFileSymmetric is set. The cells start at offset 64,
+    //so a mapping of the file is aligned for the SIMD kernels and is used without copying
+    enum struct MatrixDataType : uint32_t {
+        Float32 = 1, Float64 = 2
+    };
+
+    inline constexpr char kMatrixFileMagic[8] = {'N', 'M', 'M', 'A', 'T', 'R', 'X', '1'};
+    inline constexpr uint32_t kMatrixFileSymmetric = 1;
+    //written in the native order of the writer: a file from a machine of the other byte order reads it reversed
+    inline constexpr uint32_t kMatrixFileByteOrder = 0x01020304;
+
+    struct MatrixFileHeader {
+        char magic[8];
+        MatrixDataType type;
+        uint32_t flags;
+        uint64_t rows;
+        uint64_t columns;
+        uint32_t byte_order;
+        char reserved[28];
+
+        bool IsSymmetric() const { return flags & kMatrixFileSymmetric; }
+
+        uint64_t CellsCount() const {
+            return IsSymmetric() ? rows * (rows + 1) / 2 : rows * columns;
+        }
+
+        //bytes of the header and the cells; false when the size does not fit in 64 bits
+        bool PayloadBytes(size_t cell_size, uint64_t &bytes) const {
+            constexpr auto kMax = std::numeric_limits<uint64_t>::max();
+            uint64_t first = rows;
+            uint64_t second = columns;
+            if (IsSymmetric()) {
+                //n (n + 1) / 2 with the halving done first, so only the product can overflow
+                if (rows == kMax) return false;
+                first = rows % 2 == 0 ? rows / 2 : rows;
+                second = rows % 2 == 0 ? rows + 1 : (rows + 1) / 2;
+            }
+            if (second != 0 && first > kMax / second) return false;
+            auto cells = first * second;
+            if (cells > (kMax - sizeof(MatrixFileHeader)) / cell_size) return false;
+            bytes = cells * cell_size + sizeof(MatrixFileHeader);
+            return true;
+        }
+    };
+    static_assert(sizeof(MatrixFileHeader) == 64, "заголовок должен занимать 64 байта");
+
+    template<typename T>
+    constexpr MatrixDataType DataTypeOf() {
+        static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>, "поддерживаются только float и double");
+        return std::is_same_v<T, float> ? MatrixDataType::Float32 : MatrixDataType::Float64;
+    }
+
+    //writes the rows one by one through a buffered stream, the whole matrix is never held in memory
+    template<typename T = double>
+    class MatrixFileWriter {
+        std::ofstream out_;
+        MatrixFileHeader header_{};
+        uint64_t rows_written_ = 0;
+    public:
+        MatrixFileWriter(const std::string &path, size_t rows, size_t columns, bool symmetric = false) :
+                out_(path, std::ios::binary | std::ios::trunc) {
+            if (!out_) throw std::runtime_error("loh");
+            if (symmetric && rows != columns) throw std::invalid_argument("loh");
+            std::memcpy(header_.magic, kMatrixFileMagic, sizeof(kMatrixFileMagic));
+            header_.type = DataTypeOf<T>();
+            header_.flags = symmetric ? kMatrixFileSymmetric : 0;
+            header_.rows = rows;
+            header_.columns = columns;
+            header_.byte_order = kMatrixFileByteOrder;
+            out_.write(reinterpret_cast<const char *>(&header_), sizeof(header_));
+        }
+
+        MatrixFileWriter(const MatrixFileWriter &) = delete;
+        MatrixFileWriter &operator=(const MatrixFileWriter &) = delete;
+
+        //the row i of a symmetric file takes its columns i..n-1: row must point to the whole row
+        void WriteRow(const T *row) {
+            if (rows_written_ == header_.rows) throw std::invalid_argument("loh");
+            auto begin = header_.IsSymmetric() ? rows_written_ : 0;
+            out_.write(reinterpret_cast<const char *>(row + begin),
+                       static_cast<std::streamsize>((header_.columns - begin) * sizeof(T)));
+            if (!out_) throw std::runtime_error("loh");
+            rows_written_++;
+        }
+
+        void WriteRow(const math::StridedSpan<const T> &row) {
+            if (row.size() != header_.columns) throw std::invalid_argument("loh");
+            if (row.IsContiguous()) {
+                WriteRow(row.Data());
+                return;
+            }
+            std::vector<T> buffer(row.begin(), row.end());
+            WriteRow(buffer.data());
+        }
+
+        //throws if not every row was written
+        void Close() {
+            if (!out_.is_open()) return;
+            out_.close();
+            if (rows_written_ != header_.rows || !out_) throw std::runtime_error("loh");
+        }
+
+        ~MatrixFileWriter() {
+            if (out_.is_open()) out_.close();
+        }
+    };
+
+    //anything with nRows, nColumns and RowData: Matrix, FixedMatrix
+    template<typename Matrix>
+    void WriteMatrix(const std::string &path, const Matrix &matrix) {
+        using T = std::remove_cvref_t<decltype(*matrix.RowData(0))>;
+        MatrixFileWriter<T> writer(path, matrix.nRows(), matrix.nColumns());
+        for (size_t i = 0; i < matrix.nRows(); i++)
+            writer.WriteRow(matrix.RowData(i));
+        writer.Close();
+    }
+
+    template<typename T>
+    void WriteMatrix(const std::string &path, const math::SymmetricMatrix<T> &matrix) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) throw std::runtime_error("loh");
+        MatrixFileHeader header{};
+        std::memcpy(header.magic, kMatrixFileMagic, sizeof(kMatrixFileMagic));
+        header.type = DataTypeOf<T>();
+        header.flags = kMatrixFileSymmetric;
+        header.rows = header.columns = matrix.nRows();
+        header.byte_order = kMatrixFileByteOrder;
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char *>(matrix.Data()),
+                  static_cast<std::streamsize>(header.CellsCount() * sizeof(T)));
+        if (!out) throw std::runtime_error("loh");
+    }
+
+    namespace detail {
+        //read-only mapping of the whole file for sequential reading: mmap on POSIX,
+        //a file mapping object on Windows. Returns nullptr when the file is shorter than a header
+        inline const void *MapFile(const std::string &path, size_t &length) {
+#ifdef _WIN32
+            auto file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                    FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (file == INVALID_HANDLE_VALUE) throw std::runtime_error("loh");
+            LARGE_INTEGER size{};
+            if (!GetFileSizeEx(file, &size)) {
+                CloseHandle(file);
+                throw std::runtime_error("loh");
+            }
+            length = static_cast<size_t>(size.QuadPart);
+            const void *mapping = nullptr;
+            if (length >= sizeof(MatrixFileHeader)) {
+                //the view keeps the section alive after its handle is closed
+                if (auto section = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr)) {
+                    mapping = MapViewOfFile(section, FILE_MAP_READ, 0, 0, 0);
+                    CloseHandle(section);
+                }
+            }
+            CloseHandle(file);
+            return mapping;
+#else
+            auto descriptor = open(path.c_str(), O_RDONLY);
+            if (descriptor < 0) throw std::runtime_error("loh");
+            struct stat info{};
+            if (fstat(descriptor, &info) != 0) {
+                close(descriptor);
+                throw std::runtime_error("loh");
+            }
+            length = static_cast<size_t>(info.st_size);
+            void *mapping = MAP_FAILED;
+            if (length >= sizeof(MatrixFileHeader))
+                mapping = mmap(nullptr, length, PROT_READ, MAP_SHARED, descriptor, 0);
+            close(descriptor);
+            if (mapping == MAP_FAILED) return nullptr;
+            madvise(mapping, length, MADV_SEQUENTIAL);
+            return mapping;
+#endif
+        }
+
+        inline void UnmapFile(const void *mapping, size_t length) {
+#ifdef _WIN32
+            (void) length;
+            UnmapViewOfFile(mapping);
+#else
+            munmap(const_cast<void *>(mapping), length);
+#endif
+        }
+    }
+
+    //read-only mapping of a matrix file: View() and Packed() point straight into the page cache
+    template<typename T = double>
+    class MappedMatrixFile {
+        const void *mapping_ = nullptr;
+        size_t length_ = 0;
+        const MatrixFileHeader *header_ = nullptr;
+
+        void Unmap() {
+            if (mapping_) detail::UnmapFile(mapping_, length_);
+            mapping_ = nullptr;
+        }
+    public:
+        explicit MappedMatrixFile(const std::string &path) {
+            mapping_ = detail::MapFile(path, length_);
+            if (!mapping_) throw std::invalid_argument("loh");
+            header_ = static_cast<const MatrixFileHeader *>(mapping_);
+            uint64_t bytes = 0;
+            if (std::memcmp(header_->magic, kMatrixFileMagic, sizeof(kMatrixFileMagic)) != 0 ||
+                header_->byte_order != kMatrixFileByteOrder ||
+                header_->type != DataTypeOf<T>() ||
+                (header_->IsSymmetric() && header_->rows != header_->columns) ||
+                !header_->PayloadBytes(sizeof(T), bytes) || length_ < bytes) {
+                Unmap();
+                throw std::invalid_argument("loh");
+            }
+        }
+
+        MappedMatrixFile(MappedMatrixFile &&other) noexcept :
+                mapping_(std::exchange(other.mapping_, nullptr)),
+                length_(other.length_),
+                header_(other.header_) {}
+
+        MappedMatrixFile(const MappedMatrixFile &) = delete;
+        MappedMatrixFile &operator=(const MappedMatrixFile &) = delete;
+
+        ~MappedMatrixFile() {
+            Unmap();
+        }
+
+        const MatrixFileHeader &Header() const { return *header_; }
+        size_t nRows() const { return header_->rows; }
+        size_t nColumns() const { return header_->columns; }
+
+        const T *Data() const {
+            return reinterpret_cast<const T *>(static_cast<const char *>(mapping_) + sizeof(MatrixFileHeader));
+        }
+
+        //zero-copy view of a dense file
+        math::MatrixView<const T> View() const {
+            if (header_->IsSymmetric()) throw std::invalid_argument("loh");
+            return math::MatrixView<const T>(Data(), nRows(), nColumns(), static_cast<std::ptrdiff_t>(nColumns()));
+        }
+
+        //the packed upper triangle of a symmetric file, in the layout of SymmetricMatrix::RowData
+        const T *Packed() const {
+            if (!header_->IsSymmetric()) throw std::invalid_argument("loh");
+            return Data();
+        }
+    };
+
+    template<typename T = double>
+    math::SymmetricMatrix<T> LoadSymmetricMatrix(const MappedMatrixFile<T> &file) {
+        math::SymmetricMatrix<T> matrix(file.nRows());
+        std::copy(file.Packed(), file.Packed() + file.Header().CellsCount(), matrix.Data());
+        return matrix;
+    }
+
+    template<typename T = double>
+    math::SymmetricMatrix<T> LoadSymmetricMatrix(const std::string &path) {
+        return LoadSymmetricMatrix<T>(MappedMatrixFile<T>(path));
+    }
+
+    //copies the mapped cells into an aligned Matrix; symmetric files are expanded
+    template<typename T = double>
+    math::Matrix<T> LoadMatrix(const std::string &path) {
+        MappedMatrixFile<T> file(path);
+        if (file.Header().IsSymmetric()) return math::Matrix<T>(LoadSymmetricMatrix<T>(file));
+        math::Matrix<T> matrix(file.View());
+        return matrix;
+    }
+}
+#endif
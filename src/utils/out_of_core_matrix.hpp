@@ -0,0 +1,210 @@
+#ifndef NUMERIC_METHODS3_UTILS_OUT_OF_CORE_MATRIX
+#define NUMERIC_METHODS3_UTILS_OUT_OF_CORE_MATRIX
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include "math/aligned_allocator.hpp"
+#include "math/product.hpp"
+#include "math/vector.hpp"
+#include "math/view.hpp"
+#include "matrix_file.hpp"
+
+namespace utils {
+    namespace detail {
+        //positioned reads from a file opened for sequential access: pread on POSIX,
+        //ReadFile with an offset on Windows
+#ifdef _WIN32
+        using FileHandle = HANDLE;
+        inline const FileHandle kNoFile = INVALID_HANDLE_VALUE;
+
+        inline FileHandle OpenSequential(const std::string &path) {
+            auto file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                    FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (file == INVALID_HANDLE_VALUE) throw std::runtime_error("loh");
+            return file;
+        }
+
+        inline bool ReadAt(FileHandle file, char *target, size_t length, uint64_t offset) {
+            while (length > 0) {
+                OVERLAPPED position{};
+                position.Offset = static_cast<DWORD>(offset);
+                position.OffsetHigh = static_cast<DWORD>(offset >> 32);
+                auto chunk = static_cast<DWORD>(std::min<size_t>(length, size_t{1} << 30));
+                DWORD count = 0;
+                if (!ReadFile(file, target, chunk, &count, &position) || count == 0) return false;
+                target += count;
+                length -= count;
+                offset += count;
+            }
+            return true;
+        }
+
+        inline void CloseFile(FileHandle file) {
+            CloseHandle(file);
+        }
+#else
+        using FileHandle = int;
+        inline constexpr FileHandle kNoFile = -1;
+
+        inline FileHandle OpenSequential(const std::string &path) {
+            auto descriptor = open(path.c_str(), O_RDONLY);
+            if (descriptor < 0) throw std::runtime_error("loh");
+            posix_fadvise(descriptor, 0, 0, POSIX_FADV_SEQUENTIAL);
+            return descriptor;
+        }
+
+        inline bool ReadAt(FileHandle descriptor, char *target, size_t length, uint64_t offset) {
+            while (length > 0) {
+                auto count = pread(descriptor, target, length, static_cast<off_t>(offset));
+                if (count <= 0) return false;
+                target += count;
+                length -= static_cast<size_t>(count);
+                offset += static_cast<uint64_t>(count);
+            }
+            return true;
+        }
+
+        inline void CloseFile(FileHandle descriptor) {
+            close(descriptor);
+        }
+#endif
+    }
+
+    //a dense matrix file that is never loaded as a whole: every mat-vec streams it in panels of
+    //rows. A reader thread fills one panel buffer while the other is multiplied, so the disk and
+    //the cores work at the same time and the memory use is two panels, or one when the matrix fits
+    //in a single panel
+    template<typename T = double>
+    class OutOfCoreMatrix {
+        static constexpr size_t kDefaultPanelBytes = size_t{64} << 20;
+        using Buffer = std::vector<T, math::AlignedAllocator<T>>;
+
+        //lives on the heap, so the matrix can be moved while the reader thread points at it
+        struct Reader {
+            detail::FileHandle file = detail::kNoFile;
+            size_t columns = 0;
+            Buffer buffers[2];
+            std::thread thread;
+            std::mutex mutex;
+            std::condition_variable changed;
+            bool requested = false;
+            bool finished = false;
+            bool failed = false;
+            bool stop = false;
+            size_t first_row = 0;
+            size_t rows = 0;
+            size_t buffer = 0;
+
+            void Run() {
+                std::unique_lock lock(mutex);
+                while (true) {
+                    changed.wait(lock, [this] { return requested || stop; });
+                    if (stop) return;
+                    requested = false;
+                    auto target = reinterpret_cast<char *>(buffers[buffer].data());
+                    auto offset = static_cast<uint64_t>(sizeof(MatrixFileHeader) + first_row * columns * sizeof(T));
+                    auto length = rows * columns * sizeof(T);
+                    lock.unlock();
+                    auto ok = detail::ReadAt(file, target, length, offset);
+                    lock.lock();
+                    failed = !ok;
+                    finished = true;
+                    changed.notify_all();
+                }
+            }
+
+            void Request(size_t row, size_t count, size_t into) {
+                std::lock_guard lock(mutex);
+                first_row = row;
+                rows = count;
+                buffer = into;
+                finished = false;
+                requested = true;
+                changed.notify_all();
+            }
+
+            void Wait() {
+                std::unique_lock lock(mutex);
+                changed.wait(lock, [this] { return finished; });
+                if (failed) throw std::runtime_error("loh");
+            }
+
+            ~Reader() {
+                {
+                    std::lock_guard lock(mutex);
+                    stop = true;
+                }
+                changed.notify_all();
+                if (thread.joinable()) thread.join();
+                if (file != detail::kNoFile) detail::CloseFile(file);
+            }
+        };
+
+        size_t rows_count_;
+        size_t columns_count_;
+        size_t panel_rows_;
+        size_t panels_count_;
+        std::unique_ptr<Reader> reader_;
+        //with a single panel the matrix stays in the first buffer after the first pass
+        mutable bool resident_ = false;
+    public:
+        explicit OutOfCoreMatrix(const std::string &path, size_t panel_bytes = kDefaultPanelBytes) :
+                reader_(std::make_unique<Reader>()) {
+            {
+                MappedMatrixFile<T> file(path);
+                if (file.Header().IsSymmetric()) throw std::invalid_argument("loh");
+                rows_count_ = file.nRows();
+                columns_count_ = file.nColumns();
+            }
+            auto row_bytes = std::max<size_t>(columns_count_ * sizeof(T), 1);
+            panel_rows_ = std::clamp<size_t>(panel_bytes / row_bytes, 1, std::max<size_t>(rows_count_, 1));
+            panels_count_ = (rows_count_ + panel_rows_ - 1) / panel_rows_;
+            reader_->file = detail::OpenSequential(path);
+            reader_->columns = columns_count_;
+            //the second buffer is only read into when there is a next panel
+            reader_->buffers[0].resize(panel_rows_ * columns_count_);
+            if (panels_count_ > 1) reader_->buffers[1].resize(panel_rows_ * columns_count_);
+            reader_->thread = std::thread([reader = reader_.get()] { reader->Run(); });
+        }
+
+        size_t nRows() const { return rows_count_; }
+        size_t nColumns() const { return columns_count_; }
+        size_t PanelRows() const { return panel_rows_; }
+
+        //y = A x, returns (x, y); panel p + 1 is read while panel p is multiplied.
+        //Not thread-safe: all calls on one matrix share its reader and panel buffers,
+        //so concurrent mat-vecs need a matrix each
+        friend T GemvDot(const OutOfCoreMatrix &matrix, const math::Vector<T> &x, math::Vector<T> &y) {
+            if (x.size() != matrix.columns_count_ || y.size() != matrix.rows_count_) throw std::invalid_argument("loh");
+            auto &reader = *matrix.reader_;
+            auto panel_rows = matrix.panel_rows_;
+            auto rows_of = [&](size_t panel) {
+                return std::min(panel_rows, matrix.rows_count_ - panel * panel_rows);
+            };
+            if (matrix.panels_count_ > 0 && !matrix.resident_) reader.Request(0, rows_of(0), 0);
+            for (size_t panel = 0; panel < matrix.panels_count_; panel++) {
+                if (!matrix.resident_) reader.Wait();
+                if (panel + 1 < matrix.panels_count_)
+                    reader.Request((panel + 1) * panel_rows, rows_of(panel + 1), (panel + 1) % 2);
+                auto rows = rows_of(panel);
+                math::MatrixView<const T> block(reader.buffers[panel % 2].data(), rows, matrix.columns_count_,
+                                                static_cast<std::ptrdiff_t>(matrix.columns_count_));
+                math::GemvDot<T>(block, x.View(), math::StridedSpan<T>(y.Data() + panel * panel_rows, rows));
+            }
+            if (matrix.panels_count_ == 1) matrix.resident_ = true;
+            return math::Dot(std::min(matrix.rows_count_, matrix.columns_count_), x.Data(), y.Data());
+        }
+    };
+}
+#endif
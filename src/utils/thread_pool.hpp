@@ -0,0 +1,240 @@
+#ifndef NUMERIC_METHODS3_UTILS_THREAD_POOL
+#define NUMERIC_METHODS3_UTILS_THREAD_POOL
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace utils {
+    //pool of workers with their own task queues: a worker takes the newest task of its queue
+    //and steals the oldest task of another queue when its own is empty.
+    //Submitting work does not allocate, so the pool can be used inside allocation-free loops
+    class ThreadPool final {
+        struct Job {
+            void (*invoke)(void *context, size_t begin, size_t end);
+            void *context;
+            std::atomic<size_t> pending;
+            std::mutex mutex;
+            std::exception_ptr exception;
+        };
+
+        struct Task {
+            Job *job = nullptr;
+            size_t begin = 0;
+            size_t end = 0;
+        };
+
+        class TaskQueue {
+        public:
+            static constexpr size_t kCapacity = 256;
+
+            bool PushBack(const Task &task) {
+                std::lock_guard lock(mutex_);
+                if (count_ == kCapacity) return false;
+                tasks_[(head_ + count_) % kCapacity] = task;
+                count_++;
+                return true;
+            }
+
+            bool PopBack(Task &task) {
+                std::lock_guard lock(mutex_);
+                if (count_ == 0) return false;
+                count_--;
+                task = tasks_[(head_ + count_) % kCapacity];
+                return true;
+            }
+
+            bool PopFront(Task &task) {
+                std::lock_guard lock(mutex_);
+                if (count_ == 0) return false;
+                task = tasks_[head_];
+                head_ = (head_ + 1) % kCapacity;
+                count_--;
+                return true;
+            }
+
+        private:
+            std::mutex mutex_;
+            Task tasks_[kCapacity];
+            size_t head_ = 0;
+            size_t count_ = 0;
+        };
+
+    public:
+        //threads_count counts the calling thread too, so 1 means sequential execution
+        explicit ThreadPool(size_t threads_count) : queues_(std::max<size_t>(threads_count, 1)) {
+            for (size_t index = 1; index < queues_.size(); index++) {
+                workers_.emplace_back([this, index] { WorkerLoop(index); });
+            }
+        }
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        ~ThreadPool() {
+            {
+                std::lock_guard lock(sleep_mutex_);
+                stop_ = true;
+            }
+            wake_up_.notify_all();
+            for (auto &worker: workers_) {
+                worker.join();
+            }
+        }
+
+        size_t ThreadsCount() const {
+            return queues_.size();
+        }
+
+        //calls function(chunk_begin, chunk_end) for chunks of at most grain indices covering [begin, end)
+        //and returns when all of them are done; the calling thread executes chunks as well
+        template<typename Function>
+        void ParallelFor(size_t begin, size_t end, size_t grain, Function &&function) {
+            grain = std::max<size_t>(grain, 1);
+            if (end <= begin) return;
+            if (ThreadsCount() == 1 || end - begin <= grain) {
+                function(begin, end);
+                return;
+            }
+            using Callable = std::remove_reference_t<Function>;
+            Job job;
+            job.invoke = [](void *context, size_t chunk_begin, size_t chunk_end) {
+                (*static_cast<Callable *>(context))(chunk_begin, chunk_end);
+            };
+            job.context = const_cast<void *>(static_cast<const void *>(std::addressof(function)));
+            job.pending = (end - begin + grain - 1) / grain;
+
+            auto own = OwnQueueIndex();
+            size_t queue = own;
+            for (size_t chunk = begin; chunk < end; chunk += grain) {
+                Task task{&job, chunk, std::min(chunk + grain, end)};
+                queue = (queue + 1) % queues_.size();
+                if (!queues_[queue].PushBack(task)) {
+                    Run(task);
+                    continue;
+                }
+                queued_.fetch_add(1, std::memory_order_release);
+            }
+            {
+                std::lock_guard lock(sleep_mutex_);
+            }
+            wake_up_.notify_all();
+
+            while (job.pending.load(std::memory_order_acquire) != 0) {
+                Task task;
+                if (TryTake(own, task)) {
+                    Run(task);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+            if (job.exception) {
+                std::rethrow_exception(job.exception);
+            }
+        }
+
+        //every kernel calls this, so once the pool exists it is a single atomic load
+        static ThreadPool &Shared() {
+            if (auto pool = SharedPointer().load(std::memory_order_acquire)) return *pool;
+            std::lock_guard lock(SharedMutex());
+            auto &pool = SharedStorage();
+            if (!pool) {
+                pool = std::make_unique<ThreadPool>(std::max<unsigned>(std::thread::hardware_concurrency(), 1));
+                SharedPointer().store(pool.get(), std::memory_order_release);
+            }
+            return *pool;
+        }
+
+        //must not be called while the shared pool is running work
+        static void SetSharedThreadsCount(size_t threads_count) {
+            std::lock_guard lock(SharedMutex());
+            auto &pool = SharedStorage();
+            SharedPointer().store(nullptr, std::memory_order_release);
+            pool.reset();
+            pool = std::make_unique<ThreadPool>(threads_count);
+            SharedPointer().store(pool.get(), std::memory_order_release);
+        }
+
+    private:
+        static std::mutex &SharedMutex() {
+            static std::mutex mutex;
+            return mutex;
+        }
+
+        static std::unique_ptr<ThreadPool> &SharedStorage() {
+            static std::unique_ptr<ThreadPool> pool;
+            return pool;
+        }
+
+        static std::atomic<ThreadPool *> &SharedPointer() {
+            static std::atomic<ThreadPool *> pointer{nullptr};
+            return pointer;
+        }
+
+        static size_t &CurrentWorkerIndex() {
+            thread_local size_t index = 0;
+            return index;
+        }
+
+        size_t OwnQueueIndex() const {
+            auto index = CurrentWorkerIndex();
+            return index < queues_.size() ? index : 0;
+        }
+
+        bool TryTake(size_t own, Task &task) {
+            if (queues_[own].PopBack(task)) {
+                queued_.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+            for (size_t shift = 1; shift < queues_.size(); shift++) {
+                if (queues_[(own + shift) % queues_.size()].PopFront(task)) {
+                    queued_.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        static void Run(const Task &task) {
+            auto job = task.job;
+            try {
+                job->invoke(job->context, task.begin, task.end);
+            } catch (...) {
+                std::lock_guard lock(job->mutex);
+                if (!job->exception) job->exception = std::current_exception();
+            }
+            job->pending.fetch_sub(1, std::memory_order_acq_rel);
+        }
+
+        void WorkerLoop(size_t index) {
+            CurrentWorkerIndex() = index;
+            while (true) {
+                Task task;
+                if (TryTake(index, task)) {
+                    Run(task);
+                    continue;
+                }
+                std::unique_lock lock(sleep_mutex_);
+                wake_up_.wait(lock, [this] {
+                    return stop_ || queued_.load(std::memory_order_acquire) != 0;
+                });
+                if (stop_) return;
+            }
+        }
+
+        std::vector<TaskQueue> queues_;
+        std::vector<std::thread> workers_;
+        std::atomic<size_t> queued_{0};
+        std::mutex sleep_mutex_;
+        std::condition_variable wake_up_;
+        bool stop_ = false;
+    };
+}
+
+#endif
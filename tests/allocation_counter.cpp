@@ -0,0 +1,37 @@
+#include "allocation_counter.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    std::atomic<size_t> allocations_count{0};
+    std::atomic<size_t> allocated_bytes{0};
+}
+
+size_t AllocationsCount(){
+    return allocations_count.load();
+}
+
+size_t AllocatedBytes(){
+    return allocated_bytes.load();
+}
+
+void* operator new(size_t size){
+    allocations_count++;
+    allocated_bytes += size;
+    if (auto ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t align){
+    allocations_count++;
+    allocated_bytes += size;
+    auto alignment = static_cast<size_t>(align);
+    if (auto ptr = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)) return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { std::free(ptr); }
@@ -0,0 +1,7 @@
+#pragma once
+#include <cstddef>
+
+//the global operator new of the test binary is replaced in allocation_counter.cpp to count
+//the heap allocations made by the code under test
+size_t AllocationsCount();
+size_t AllocatedBytes();
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <math/arena_allocator.hpp>
+#include <math/pool_allocator.hpp>
+#include <math/solver.hpp>
+#include <utils/generator.hpp>
+#include "allocation_counter.hpp"
+#include <cstdint>
+#include <type_traits>
+
+namespace {
+    using ArenaMatrix = math::Matrix<double, math::ArenaAllocator<double>>;
+    using PoolMatrix = math::Matrix<double, math::PoolAllocator<double>>;
+
+    constexpr utils::Traits<double> kGeneratorTraits{.kMin = -10, .kMax = 10, .kSize = 64};
+    using ArenaGenerator = utils::Generator<double, kGeneratorTraits, utils::RandomSeed::No,
+            std::uniform_real_distribution<double>, math::ArenaAllocator<double>>;
+    using HeapGenerator = utils::Generator<double, kGeneratorTraits>;
+    constexpr math::Traits<double> kSolverTraits{
+            .kMin = -1,
+            .kMax = 1,
+            .kEpsEigenVector = 1e-10,
+            .kEpsEigenLambda = 1e-12,
+            .kMaxCountIterations = 100000
+    };
+    using ArenaSolver = math::Solver<double, kSolverTraits, math::RandomSeed::No,
+            std::uniform_real_distribution<>, ArenaMatrix>;
+    using HeapSolver = math::Solver<double, kSolverTraits, math::RandomSeed::No,
+            std::uniform_real_distribution<>>;
+
+    //GenerateAll + Solve; returns the heap bytes it took
+    template<typename Generator, typename Solver>
+    size_t HeapBytesOfCycle(double& lambda){
+        auto before = AllocatedBytes();
+        Generator generator;
+        generator.GenerateAll();
+        Solver solver(kGeneratorTraits.kSize, std::get<3>(generator.GetAll()), std::vector<math::EigenPair<>>{});
+        solver.Solve();
+        lambda = std::get<1>(solver.GetAll());
+        return AllocatedBytes() - before;
+    }
+
+    bool IsAligned(const void *ptr){
+        return reinterpret_cast<std::uintptr_t>(ptr) % math::kCacheLineSize == 0;
+    }
+}
+
+TEST(AllocatorTests, ArenaBumpsAndResets){
+    math::Arena arena(1024);
+    auto first = arena.Allocate(100);
+    auto second = arena.Allocate(10);
+    ASSERT_TRUE(IsAligned(first));
+    ASSERT_TRUE(IsAligned(second));
+    ASSERT_EQ(static_cast<std::byte *>(second) - static_cast<std::byte *>(first), 128);
+    arena.Deallocate(second, 10);
+    ASSERT_EQ(arena.Allocate(10), second);
+    auto large = arena.Allocate(4096);
+    ASSERT_TRUE(IsAligned(large));
+    auto capacity = arena.Capacity();
+    arena.Reset();
+    ASSERT_EQ(arena.Used(), 0);
+    ASSERT_EQ(arena.Allocate(100), first);
+    arena.Allocate(4096);
+    ASSERT_EQ(arena.Capacity(), capacity);
+}
+
+TEST(AllocatorTests, PoolReusesSizeClass){
+    math::SizeClassPool pool;
+    auto block = pool.Allocate(1000);
+    ASSERT_TRUE(IsAligned(block));
+    pool.Deallocate(block, 1000);
+    ASSERT_EQ(pool.Cached(), 1024);
+    ASSERT_EQ(pool.Allocate(900), block);
+    ASSERT_EQ(pool.Cached(), 0);
+    pool.Deallocate(block, 900);
+    pool.Release();
+    ASSERT_EQ(pool.Cached(), 0);
+}
+
+TEST(AllocatorTests, MatrixWithAllocator){
+    math::Matrix<> matrix{{1, 2}, {3, 4}};
+    PoolMatrix pooled(matrix);
+    auto sum = pooled + pooled;
+    static_assert(std::is_same_v<decltype(sum), PoolMatrix>);
+    ASSERT_EQ(math::Matrix<>(sum), matrix * 2);
+    ASSERT_EQ(math::Matrix<>(pooled * pooled), matrix * matrix);
+    ASSERT_EQ(math::Matrix<>(pooled.Transposition()), matrix.Transposition());
+    PoolMatrix lazy = math::Transposed(pooled) - pooled;
+    ASSERT_EQ(math::Matrix<>(lazy), matrix.Transposition() - matrix);
+    ASSERT_EQ(math::Abs(pooled), math::Abs(matrix));
+    ASSERT_EQ(math::Matrix<>(math::Normalized(pooled)), math::Normalized(matrix));
+    ASSERT_EQ(math::Abs(math::Matrix<float>{{3, 4}}), 5);
+}
+
+TEST(AllocatorTests, VectorWithAllocator){
+    math::Vector<double, math::PoolAllocator<double>> vector{3, 4};
+    auto sum = vector + vector * 2;
+    static_assert(std::is_same_v<decltype(sum), decltype(vector)>);
+    ASSERT_EQ(sum[0], 9);
+    ASSERT_EQ(math::Dot(sum, math::Vector<>{1, 1}), 21);
+    PoolMatrix matrix(math::Matrix<>{{1, 2}, {3, 4}});
+    auto product = matrix * vector;
+    ASSERT_EQ(product[0], 11);
+    ASSERT_EQ(product[1], 25);
+}
+
+//after the first cycle the arena holds every buffer of the next one: matrices and vectors alike
+TEST(AllocatorTests, GenerateAndSolveInArena){
+    constexpr size_t kMatrixBytes = kGeneratorTraits.kSize * kGeneratorTraits.kSize * sizeof(double);
+    auto& arena = math::ThreadArena();
+    double heap_lambda = 0;
+    auto heap_bytes = HeapBytesOfCycle<HeapGenerator, HeapSolver>(heap_lambda);
+    ASSERT_GE(heap_bytes, 4 * kMatrixBytes);
+
+    double lambda = 0;
+    arena.Reset();
+    HeapBytesOfCycle<ArenaGenerator, ArenaSolver>(lambda);
+    auto capacity = arena.Capacity();
+    arena.Reset();
+    ASSERT_EQ((HeapBytesOfCycle<ArenaGenerator, ArenaSolver>(lambda)), 0);
+    ASSERT_EQ(arena.Capacity(), capacity);
+    ASSERT_EQ(lambda, heap_lambda);
+    arena.Reset();
+}
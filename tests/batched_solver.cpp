@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <math/batched_solver.hpp>
+#include <utils/generator.hpp>
+
+namespace {
+    constexpr utils::Traits<double> kGeneratorTraits{
+            .kMin = -10,
+            .kMax = 10,
+            .kSize = 5
+    };
+    constexpr math::Traits<double> kTraits{
+            .kMin = -1,
+            .kMax = 1,
+            .kEpsEigenVector = 1e-12,
+            .kEpsEigenLambda = 1e-14,
+            .kMaxCountIterations = 100000
+    };
+    using Distribution = std::uniform_real_distribution<>;
+}
+
+TEST(BatchedSolverTests, MatchesSolver){
+    constexpr size_t kCount = 150;
+    std::vector<math::Matrix<>> matrices;
+    std::vector<math::EigenPair<>> found;
+    utils::Generator<double, kGeneratorTraits> generator;
+    for (size_t p = 0; p < kCount; p++){
+        generator.GenerateAll();
+        const auto& [vector, house_m, diag_m, result_m] = generator.GetAll();
+        size_t max = 0;
+        for (size_t i = 1; i < kGeneratorTraits.kSize; i++)
+            if (std::abs(diag_m[i][i]) > std::abs(diag_m[max][max])) max = i;
+        matrices.push_back(result_m);
+        found.push_back({diag_m[max][max], math::Vector<>(house_m.Column(max))});
+    }
+    math::BatchedSolver<double, kTraits, math::RandomSeed::No, Distribution> batched(
+            kGeneratorTraits.kSize, matrices, found);
+    batched.Solve();
+    const auto& [previous_lambdas, lambdas, count_iterations] = batched.GetAll();
+    for (size_t p = 0; p < kCount; p++){
+        math::Solver<double, kTraits, math::RandomSeed::No, Distribution> solver(
+                kGeneratorTraits.kSize, matrices[p], found[p].lambda, found[p].vector);
+        solver.Solve();
+        const auto& [previous_lambda, lambda, x, previous_x, count_iteration] = solver.GetAll();
+        ASSERT_NEAR(lambdas[p], lambda, 1e-9);
+        auto batched_x = math::Normalized(batched.GetVector(p));
+        auto expected_x = math::Normalized(x);
+        //for a negative lambda the sign of x alternates between iterations
+        ASSERT_NEAR(std::abs(math::Dot(batched_x, expected_x)), 1, 1e-10);
+    }
+}
+
+TEST(BatchedSolverTests, Validation){
+    using TestBatched = math::BatchedSolver<double, kTraits, math::RandomSeed::No, Distribution>;
+    std::vector<math::Matrix<>> matrices{math::Matrix<>(3), math::Matrix<>(4)};
+    ASSERT_THROW(TestBatched(3, matrices), std::invalid_argument);
+    matrices.pop_back();
+    ASSERT_THROW(TestBatched(3, matrices, {{1, math::Vector<>(3)}, {1, math::Vector<>(3)}}), std::invalid_argument);
+}
+
+TEST(BatchedSolverTests, FloatNumber){
+    constexpr math::Traits<float> traits{
+            .kMin = -1,
+            .kMax = 1,
+            .kEpsEigenVector = 1e-5,
+            .kEpsEigenLambda = 1e-6,
+            .kMaxCountIterations = 100000
+    };
+    constexpr size_t kCount = 40;
+    std::vector<math::Matrix<float>> matrices;
+    for (size_t p = 0; p < kCount; p++){
+        math::Matrix<float> matrix(3);
+        matrix[0][0] = 5 + static_cast<float>(p) / 8;
+        matrix[1][1] = -2;
+        matrix[2][2] = 1;
+        matrices.push_back(matrix);
+    }
+    math::BatchedSolver<float, traits, math::RandomSeed::No, std::uniform_real_distribution<float>> batched(3, matrices);
+    batched.Solve();
+    const auto& [previous_lambdas, lambdas, count_iterations] = batched.GetAll();
+    static_assert(std::is_same_v<std::remove_cvref_t<decltype(lambdas)>, std::vector<float>>);
+    for (size_t p = 0; p < kCount; p++){
+        ASSERT_NEAR(lambdas[p], matrices[p][0][0], 1e-4);
+    }
+}
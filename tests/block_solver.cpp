@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <math/block_solver.hpp>
+#include <utils/generator.hpp>
+#include "allocation_counter.hpp"
+#include <algorithm>
+
+TEST(BlockSolverTests, SymmetricEigen){
+    math::Matrix<> matrix{
+            {4, 1, 0},
+            {1, 3, 1},
+            {0, 1, 2}
+    };
+    auto [values, vectors] = math::SymmetricEigen(matrix);
+    for (size_t i = 0; i < 3; i++){
+        math::Vector<> vector(vectors.Column(i));
+        auto image = matrix * vector;
+        for (size_t j = 0; j < 3; j++)
+            ASSERT_NEAR(image[j], values[i] * vector[j], 1e-12);
+        if (i > 0){
+            ASSERT_GE(std::abs(values[i - 1]), std::abs(values[i]));
+        }
+    }
+}
+
+TEST(BlockSolverTests, TopEigenpairs){
+    constexpr utils::Traits<double> generator_traits{
+            .kMin = -10,
+            .kMax = 10,
+            .kSize = 30
+    };
+    utils::Generator<double, generator_traits> generator;
+    generator.GenerateAll();
+    const auto& [vector, house_m, diag_m, result_m] = generator.GetAll();
+    std::vector<double> expected;
+    for (size_t i = 0; i < generator_traits.kSize; i++) expected.push_back(diag_m[i][i]);
+    std::sort(expected.begin(), expected.end(), [](double left, double right){
+        return std::abs(left) > std::abs(right);
+    });
+
+    constexpr math::Traits<double> traits{
+            .kMin = -1,
+            .kMax = 1,
+            .kEpsEigenVector = 1e-9,
+            .kEpsEigenLambda = -1,
+            .kMaxCountIterations = 100000
+    };
+    math::BlockSolver<double, traits, math::RandomSeed::No, std::uniform_real_distribution<>> solver(
+            generator_traits.kSize, result_m, 3, 2);
+    solver.Solve();
+    const auto& [lambdas, vectors, count_iteration] = solver.GetAll();
+    for (size_t i = 0; i < 3; i++){
+        ASSERT_NEAR(lambdas[i], expected[i], 1e-8);
+        math::Vector<> eigen_vector(vectors.Row(i));
+        auto image = result_m * eigen_vector;
+        for (size_t j = 0; j < generator_traits.kSize; j++)
+            ASSERT_NEAR(image[j], lambdas[i] * eigen_vector[j], 1e-8);
+    }
+}
+
+//a run cut by kMaxCountIterations still ends on Ritz pairs of an orthonormal block, without allocating
+TEST(BlockSolverTests, StopsOnRitzPairs){
+    constexpr utils::Traits<double> generator_traits{
+            .kMin = -10,
+            .kMax = 10,
+            .kSize = 30
+    };
+    utils::Generator<double, generator_traits> generator;
+    generator.GenerateAll();
+    const auto& result_m = std::get<3>(generator.GetAll());
+    constexpr math::Traits<double> traits{
+            .kMin = -1,
+            .kMax = 1,
+            .kEpsEigenVector = -1,
+            .kEpsEigenLambda = -1,
+            .kMaxCountIterations = 5
+    };
+    math::BlockSolver<double, traits, math::RandomSeed::No, std::uniform_real_distribution<>> solver(
+            generator_traits.kSize, result_m, 3, 3);
+    auto before = AllocationsCount();
+    solver.Solve();
+    ASSERT_EQ(AllocationsCount(), before);
+    const auto& [lambdas, vectors, count_iteration] = solver.GetAll();
+    ASSERT_EQ(count_iteration, 5);
+    for (size_t i = 0; i < 3; i++){
+        math::Vector<> eigen_vector(vectors.Row(i));
+        for (size_t k = 0; k < 3; k++){
+            math::Vector<> other(vectors.Row(k));
+            ASSERT_NEAR(math::Dot(eigen_vector, other), i == k ? 1 : 0, 1e-12);
+        }
+        ASSERT_NEAR(math::Dot(eigen_vector, result_m * eigen_vector), lambdas[i], 1e-9);
+    }
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include <math/expression.hpp>
+#include "allocation_counter.hpp"
+
+TEST(ExpressionTests, HouseholderRankOneUpdate){
+    math::Vector<> vector{0.6, 0.8};
+    math::Matrix<> result = math::Identity<>(2) - 2 * math::Outer(vector, vector);
+    math::Matrix<> expected = math::MakeIdentityMatrix<>(2) - 2 * math::Outer(vector, vector);
+    ASSERT_TRUE(result == expected);
+    ASSERT_NEAR(result[0][0], 1 - 2 * 0.36, 1e-15);
+    ASSERT_NEAR(result[0][1], -2 * 0.48, 1e-15);
+    ASSERT_NEAR(result[1][1], 1 - 2 * 0.64, 1e-15);
+}
+
+TEST(ExpressionTests, MixedOperands){
+    math::Matrix<> left{
+            {1, 2, 3},
+            {4, 5, 6}
+    };
+    math::Matrix<> right{
+            {1, 1},
+            {2, 2},
+            {3, 3}
+    };
+    math::Matrix<> sum = left + math::Transposed(right) * 2.0 - math::Lazy(left);
+    math::Matrix<> expected{
+            {2, 4, 6},
+            {2, 4, 6}
+    };
+    ASSERT_TRUE(sum == expected);
+    ASSERT_THROW(math::Lazy(left) + right, std::invalid_argument);
+    math::Matrix<> negated = -math::Lazy(left);
+    ASSERT_EQ(negated[1][2], -6);
+}
+
+TEST(ExpressionTests, AssignsInPlace){
+    math::Vector<> vector{0.6, 0.8, 0};
+    math::Matrix<> matrix(3);
+    auto data = matrix.Data();
+    auto before = AllocationsCount();
+    matrix = math::Identity<>(3) - 2 * math::Outer(vector, vector);
+    ASSERT_EQ(AllocationsCount(), before);
+    ASSERT_EQ(matrix.Data(), data);
+    ASSERT_NEAR(matrix[0][1], -2 * 0.48, 1e-15);
+    ASSERT_EQ(matrix[2][2], 1);
+}
+
+TEST(ExpressionTests, AssignsAliasedThroughTemporary){
+    math::Matrix<> matrix{
+            {1, 2},
+            {3, 4}
+    };
+    math::Matrix<> expected{
+            {1, 3},
+            {2, 4}
+    };
+    matrix = math::Transposed(matrix);
+    ASSERT_TRUE(matrix == expected);
+    matrix = matrix.TransposedView();
+    ASSERT_TRUE(matrix == expected.Transposition());
+    math::Vector<> column(matrix.Column(1));
+    matrix = math::Lazy(matrix) - math::Outer(matrix.Column(0), column.View());
+    ASSERT_EQ(matrix[1][1], 4 - 3 * 4);
+}
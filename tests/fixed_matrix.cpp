@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <math/solver.hpp>
+#include <math/fixed_matrix.hpp>
+#include <utils/generator.hpp>
+#include "allocation_counter.hpp"
+#include <type_traits>
+
+namespace {
+    constexpr math::FixedMatrix<double, 2, 3> kLeft{
+            {1, 2, 3},
+            {4, 5, 6}
+    };
+    constexpr math::FixedMatrix<double, 3, 2> kRight{
+            {7, 8},
+            {9, 10},
+            {11, 12}
+    };
+    constexpr math::FixedMatrix<double, 2, 2> kProduct{
+            {58, 64},
+            {139, 154}
+    };
+    static_assert(kLeft * kRight == kProduct);
+    static_assert(kLeft.Transposition().Transposition() == kLeft);
+    static_assert(kProduct * math::MakeFixedIdentityMatrix<double, 2>() == kProduct);
+    static_assert(kProduct - kProduct + 2.0 * kProduct == kProduct * 2.0);
+    static_assert(std::is_same_v<decltype(2 * kProduct), math::FixedMatrix<double, 2, 2>>);
+    static_assert(2 * kProduct == kProduct * 2.0 && kProduct * 2 == 2.0 * kProduct);
+    static_assert((kLeft * std::array<double, 3>{1, 0, -1})[1] == -2);
+
+    static_assert(std::is_same_v<math::MatrixFor<double, 4, 4>, math::FixedMatrix<double, 4, 4>>);
+    static_assert(std::is_same_v<math::MatrixFor<double, 17, 17>, math::Matrix<double>>);
+    static_assert(std::is_same_v<math::VectorFor<double, 4>, math::FixedVector<double, 4>>);
+    static_assert(std::is_same_v<math::VectorFor<double, 17>, math::Vector<double>>);
+    static_assert(math::Dot(math::FixedVector<double, 2>{3, 4}, math::FixedVector<double, 2>{3, 4}) == 25);
+
+    constexpr math::Traits<double> kSolverTraits{
+            .kMin = -1,
+            .kMax = 1,
+            .kEpsEigenVector = 1e-12,
+            .kEpsEigenLambda = 1e-14,
+            .kMaxCountIterations = 100000
+    };
+
+    //GenerateAll + Solve of a kSize x kSize problem; returns the number of heap allocations
+    template<size_t kSize>
+    size_t AllocationsOfCycle(){
+        constexpr utils::Traits<double> generator_traits{.kMin = -10, .kMax = 10, .kSize = kSize};
+        using Generator = utils::Generator<double, generator_traits>;
+        using Solver = math::Solver<double, kSolverTraits, math::RandomSeed::No,
+                std::uniform_real_distribution<>, typename Generator::Matrix>;
+        auto before = AllocationsCount();
+        Generator generator;
+        generator.GenerateAll();
+        Solver solver(kSize, std::get<3>(generator.GetAll()), {});
+        solver.Solve();
+        return AllocationsCount() - before;
+    }
+}
+
+TEST(FixedMatrixTests, MatchesMatrix){
+    math::Matrix<> left(kLeft);
+    math::Matrix<> right(kRight);
+    ASSERT_EQ(left * right, math::Matrix<>(kProduct));
+    ASSERT_EQ(math::Matrix<>(kLeft * kLeft.TransposedView()), left * left.TransposedView());
+    ASSERT_EQ(kLeft[1][2], 6);
+    ASSERT_EQ(kLeft.Column(1)[1], 5);
+    auto image = kLeft * math::Vector<>{1, 1, 1};
+    ASSERT_EQ(image, (math::Vector<>{6, 15}));
+}
+
+TEST(FixedMatrixTests, GeneratorAndSolver){
+    constexpr utils::Traits<double> generator_traits{
+            .kMin = -10,
+            .kMax = 10,
+            .kSize = 4
+    };
+    using Generator = utils::Generator<double, generator_traits>;
+    static_assert(std::is_same_v<Generator::Matrix, math::FixedMatrix<double, 4, 4>>);
+    Generator generator;
+    generator.GenerateAll();
+    const auto& [vector, house_m, diag_m, result_m] = generator.GetAll();
+    constexpr math::Traits<double> traits{
+            .kMin = -1,
+            .kMax = 1,
+            .kEpsEigenVector = 1e-12,
+            .kEpsEigenLambda = 1e-14,
+            .kMaxCountIterations = 100000
+    };
+    using Distribution = std::uniform_real_distribution<>;
+    math::Solver<double, traits, math::RandomSeed::No, Distribution, Generator::Matrix> fixed_solver(
+            4, result_m, std::vector<math::EigenPair<>>{});
+    math::Solver<double, traits, math::RandomSeed::No, Distribution> dense_solver(
+            4, result_m, std::vector<math::EigenPair<>>{});
+    fixed_solver.Solve();
+    dense_solver.Solve();
+    ASSERT_NEAR(std::get<1>(fixed_solver.GetAll()), std::get<1>(dense_solver.GetAll()), 1e-12);
+}
+
+TEST(FixedMatrixTests, CycleWithoutHeap){
+    ASSERT_EQ(AllocationsOfCycle<3>(), 0);
+    ASSERT_EQ(AllocationsOfCycle<4>(), 0);
+}
@@ -52,4 +52,18 @@ TEST(MatrixTests, Transposition){
     };
     math::Matrix<> result = left.Transposition();
     ASSERT_TRUE(result == expected);
-}
\ No newline at end of file
+}
+TEST(MatrixTests, AlignedRows){
+    math::Matrix<> matrix(5, 11);
+    ASSERT_GE(matrix.Stride(), matrix.nColumns());
+    for (size_t i = 0; i < matrix.nRows(); i++){
+        ASSERT_EQ(reinterpret_cast<std::uintptr_t>(matrix.RowData(i)) % math::kCacheLineSize, 0);
+        for (size_t j = 0; j < matrix.nColumns(); j++){
+            matrix[i][j] = i * 100 + j;
+        }
+    }
+    math::Matrix<> copy = matrix;
+    ASSERT_TRUE(copy == matrix);
+    ASSERT_EQ(copy[4][10], 410);
+    ASSERT_TRUE(copy.Transposition().Transposition() == matrix);
+}
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+#include <math/matrix.hpp>
+#include <random>
+
+namespace {
+    template<typename T>
+    math::Matrix<T> RandomMatrix(size_t rows, size_t columns, std::mt19937& generator){
+        std::uniform_real_distribution<T> distribution{-1, 1};
+        math::Matrix<T> matrix(rows, columns);
+        for (size_t i = 0; i < rows; i++)
+            for (size_t j = 0; j < columns; j++)
+                matrix[i][j] = distribution(generator);
+        return matrix;
+    }
+
+    template<typename T>
+    math::Matrix<T> NaiveProduct(const math::Matrix<T>& left, const math::Matrix<T>& right){
+        math::Matrix<T> result(left.nRows(), right.nColumns());
+        for (size_t i = 0; i < left.nRows(); i++)
+            for (size_t j = 0; j < right.nColumns(); j++){
+                double sum = 0;
+                for (size_t k = 0; k < left.nColumns(); k++)
+                    sum += double(left[i][k]) * right[k][j];
+                result[i][j] = sum;
+            }
+        return result;
+    }
+
+    template<typename T>
+    void CheckAllLevels(double eps){
+        std::mt19937 generator{0};
+        for (auto [m, k, n] : {std::make_tuple(1, 1, 1), std::make_tuple(3, 3, 3), std::make_tuple(7, 130, 37),
+                               std::make_tuple(67, 259, 300)}){
+            auto left = RandomMatrix<T>(m, k, generator);
+            auto right = RandomMatrix<T>(k, n, generator);
+            auto expected = NaiveProduct(left, right);
+            for (auto level : {math::SimdLevel::Scalar, math::SimdLevel::Avx2, math::SimdLevel::Avx512}){
+                math::LimitSimdLevel(level);
+                auto result = left * right;
+                for (size_t i = 0; i < result.nRows(); i++)
+                    for (size_t j = 0; j < result.nColumns(); j++)
+                        ASSERT_NEAR(result[i][j], expected[i][j], eps * k);
+            }
+            math::LimitSimdLevel(math::SimdLevel::Avx512);
+        }
+    }
+}
+
+TEST(GemmTests, Double){
+    CheckAllLevels<double>(1e-14);
+}
+
+TEST(GemmTests, Float){
+    CheckAllLevels<float>(1e-5);
+}
+
+TEST(GemmTests, Integer){
+    math::Matrix<int> left{{1, 2}, {3, 4}};
+    math::Matrix<int> expected{{7, 10}, {15, 22}};
+    ASSERT_TRUE(left * left == expected);
+}
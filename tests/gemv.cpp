@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+#include <math/vector.hpp>
+#include <math/expression.hpp>
+#include <random>
+
+TEST(GemvTests, GemvDot){
+    std::mt19937 generator{1};
+    std::uniform_real_distribution<> distribution{-1, 1};
+    for (size_t n : {1, 3, 7, 33, 130}){
+        math::Matrix<> matrix(n + 2, n);
+        math::Vector<> vector(n);
+        for (size_t i = 0; i < matrix.nRows(); i++)
+            for (size_t j = 0; j < n; j++)
+                matrix[i][j] = distribution(generator);
+        for (auto& elem : vector) elem = distribution(generator);
+        for (auto level : {math::SimdLevel::Scalar, math::SimdLevel::Avx2, math::SimdLevel::Avx512}){
+            math::LimitSimdLevel(level);
+            math::Vector<> result(n + 2);
+            auto dot = math::GemvDot(matrix, vector, result);
+            double expected_dot = 0;
+            for (size_t i = 0; i < matrix.nRows(); i++){
+                double expected = 0;
+                for (size_t j = 0; j < n; j++) expected += matrix[i][j] * vector[j];
+                ASSERT_NEAR(result[i], expected, 1e-13);
+                if (i < n) expected_dot += vector[i] * expected;
+            }
+            ASSERT_NEAR(dot, expected_dot, 1e-12);
+            ASSERT_NEAR(math::Dot(vector, vector), math::Abs(vector) * math::Abs(vector), 1e-12);
+        }
+        math::LimitSimdLevel(math::SimdLevel::Avx512);
+    }
+}
+
+TEST(GemvTests, VectorArithmetic){
+    math::Vector<> vector{3, 4};
+    ASSERT_EQ(math::Abs(vector), 5);
+    ASSERT_TRUE(math::Normalized(vector) == (math::Vector<>{0.6, 0.8}));
+    ASSERT_TRUE(vector * -1 - vector == (math::Vector<>{-6, -8}));
+    math::Matrix<> expected{{9, 12}, {12, 16}};
+    ASSERT_TRUE(math::Outer(vector, vector) == expected);
+}
@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+#include <math/solver.hpp>
+#include <utils/generator.hpp>
+
+TEST(HouseholderTests, StructuredMatchesDense){
+    constexpr utils::Traits<double> traits{
+            .kMin = -10,
+            .kMax = 10,
+            .kSize = 40
+    };
+    utils::Generator<double, traits> generator;
+    generator.GenerateAll();
+    const auto& [vector, house_m, diag_m, result_m] = generator.GetAll();
+    const auto& [house_holder, diagonal, result] = generator.GetOperators();
+    auto expected = house_m * diag_m * house_m.TransposedView();
+    math::Vector<> x(traits.kSize), y(traits.kSize), z(traits.kSize);
+    for (size_t i = 0; i < traits.kSize; i++){
+        x[i] = i % 7 - 3.0;
+    }
+    result.Apply(x.View(), y.View());
+    math::GemvDot(expected, x, z);
+    for (size_t i = 0; i < traits.kSize; i++){
+        ASSERT_NEAR(y[i], z[i], 1e-12);
+        for (size_t j = 0; j < traits.kSize; j++){
+            ASSERT_NEAR(result_m[i][j], expected[i][j], 1e-12);
+            ASSERT_EQ(house_m[i][j], house_m[j][i]);
+        }
+        if (i > 0){
+            ASSERT_GE(std::abs(diag_m[i][i]) - std::abs(diag_m[i - 1][i - 1]), 0.0001 - 1e-12);
+        }
+    }
+    house_holder.Apply(x.View(), y.View());
+    house_holder.Apply(y.View(), y.View());
+    for (size_t i = 0; i < traits.kSize; i++){
+        ASSERT_NEAR(y[i], x[i], 1e-12);
+    }
+}
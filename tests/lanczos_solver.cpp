@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <math/lanczos_solver.hpp>
+#include <utils/generator.hpp>
+#include <algorithm>
+
+namespace {
+    constexpr utils::Traits<double> kGeneratorTraits{
+            .kMin = -10,
+            .kMax = 10,
+            .kSize = 100
+    };
+    constexpr math::Traits<double> kTraits{
+            .kMin = -1,
+            .kMax = 1,
+            .kEpsEigenVector = 1e-10,
+            .kEpsEigenLambda = -1,
+            .kMaxCountIterations = 100000
+    };
+    using TestLanczos = math::LanczosSolver<double, kTraits, math::RandomSeed::No, std::uniform_real_distribution<>>;
+    using TestPower = math::Solver<double, kTraits, math::RandomSeed::No, std::uniform_real_distribution<>>;
+}
+
+TEST(LanczosSolverTests, DominantEigenpair){
+    utils::Generator<double, kGeneratorTraits> generator;
+    generator.GenerateAll();
+    const auto& [vector, house_m, diag_m, result_m] = generator.GetAll();
+    std::vector<double> expected;
+    for (size_t i = 0; i < kGeneratorTraits.kSize; i++) expected.push_back(diag_m[i][i]);
+    std::sort(expected.begin(), expected.end(), [](double left, double right){
+        return std::abs(left) > std::abs(right);
+    });
+
+    TestLanczos lanczos(kGeneratorTraits.kSize, result_m, std::vector<math::EigenPair<>>{});
+    lanczos.Solve();
+    const auto& [previous_lambda, lambda, x, previous_x, count_iteration] = lanczos.GetAll();
+    ASSERT_NEAR(lambda, expected[0], 1e-8);
+    auto image = result_m * x;
+    for (size_t i = 0; i < kGeneratorTraits.kSize; i++)
+        ASSERT_NEAR(image[i], lambda * x[i], 1e-8);
+
+    TestPower power(kGeneratorTraits.kSize, result_m, std::vector<math::EigenPair<>>{});
+    power.Solve();
+    const auto& power_count = std::get<4>(power.GetAll());
+    ASSERT_LT(count_iteration, power_count);
+}
+
+TEST(LanczosSolverTests, DeflatesFoundPair){
+    utils::Generator<double, kGeneratorTraits> generator;
+    generator.GenerateAll();
+    const auto& [vector, house_m, diag_m, result_m] = generator.GetAll();
+    TestLanczos first(kGeneratorTraits.kSize, result_m, std::vector<math::EigenPair<>>{});
+    first.Solve();
+    const auto& [first_previous, first_lambda, first_x, first_previous_x, first_count] = first.GetAll();
+
+    TestLanczos second(kGeneratorTraits.kSize, result_m, first_lambda, first_x, 8);
+    second.Solve();
+    const auto& [previous_lambda, lambda, x, previous_x, count_iteration] = second.GetAll();
+    auto image = result_m * x;
+    for (size_t i = 0; i < kGeneratorTraits.kSize; i++)
+        ASSERT_NEAR(image[i], lambda * x[i], 1e-8);
+    ASSERT_LE(std::abs(lambda), std::abs(first_lambda));
+    ASSERT_GT(std::abs(first_lambda - lambda), 1e-6);
+}
+
+TEST(LanczosSolverTests, RestartsWithSmallBasis){
+    constexpr math::Traits<double> traits{
+            .kMin = -1,
+            .kMax = 1,
+            .kEpsEigenVector = 1e-10,
+            .kEpsEigenLambda = 1e-13,
+            .kMaxCountIterations = 100000
+    };
+    utils::Generator<double, kGeneratorTraits> generator;
+    generator.GenerateAll();
+    const auto& [vector, house_m, diag_m, result_m] = generator.GetAll();
+    double expected = 0;
+    for (size_t i = 0; i < kGeneratorTraits.kSize; i++)
+        if (std::abs(diag_m[i][i]) > std::abs(expected)) expected = diag_m[i][i];
+
+    math::LanczosSolver<double, traits, math::RandomSeed::No, std::uniform_real_distribution<>> lanczos(
+            kGeneratorTraits.kSize, result_m, std::vector<math::EigenPair<>>{}, 4);
+    lanczos.Solve();
+    const auto& [previous_lambda, lambda, x, previous_x, count_iteration] = lanczos.GetAll();
+    ASSERT_GT(count_iteration, 4);
+    ASSERT_LT(count_iteration, traits.kMaxCountIterations);
+    ASSERT_NEAR(lambda, expected, 1e-8);
+    auto residual = result_m * x - lambda * x;
+    ASSERT_LT(std::sqrt(math::Dot(residual, residual)), 1e-6);
+}
+
+TEST(LanczosSolverTests, FloatNumber){
+    constexpr math::Traits<float> traits{
+            .kMin = -1,
+            .kMax = 1,
+            .kEpsEigenVector = 1e-4,
+            .kEpsEigenLambda = -1,
+            .kMaxCountIterations = 10000
+    };
+    math::Matrix<float> matrix(20);
+    for (size_t i = 0; i < 20; i++) matrix[i][i] = static_cast<float>(i) - 12.5f;
+    for (size_t i = 0; i + 1 < 20; i++) matrix[i][i + 1] = matrix[i + 1][i] = 0.25f;
+    math::LanczosSolver<float, traits, math::RandomSeed::No, std::uniform_real_distribution<float>> lanczos(
+            20, matrix, std::vector<math::EigenPair<float>>{});
+    lanczos.Solve();
+    const auto& [previous_lambda, lambda, x, previous_x, count_iteration] = lanczos.GetAll();
+    static_assert(std::is_same_v<std::remove_cvref_t<decltype(x)>, math::Vector<float>>);
+    auto image = matrix * x;
+    for (size_t i = 0; i < 20; i++)
+        ASSERT_NEAR(image[i], lambda * x[i], 1e-3);
+    ASSERT_LT(lambda, -12.5f);
+}
@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+#include <utils/log.hpp>
+#include <math/matrix.hpp>
+#include <sstream>
+#include <type_traits>
+
+namespace {
+    int evaluations = 0;
+
+    int Counted(){
+        return ++evaluations;
+    }
+}
+
+TEST(LogTests, DisabledLevelsAreNotEvaluated){
+    std::ostringstream out;
+    utils::SetLogStream(out);
+    evaluations = 0;
+    NM_LOG(Trace, "value " << Counted());
+    NM_LOG(Error, "value " << Counted());
+    utils::SetLogStream(std::clog);
+    ASSERT_EQ(evaluations, utils::IsLogEnabled(utils::LogLevel::Trace) + utils::IsLogEnabled(utils::LogLevel::Error));
+    if (utils::IsLogEnabled(utils::LogLevel::Error)){
+        ASSERT_NE(out.str().find("[error] value"), std::string::npos);
+    } else {
+        ASSERT_TRUE(out.str().empty());
+    }
+    static_assert(!utils::IsLogEnabled(utils::LogLevel::Off));
+    static_assert(std::is_empty_v<utils::TimingSpan<utils::LogLevel::Off>>);
+}
+
+TEST(LogTests, Summary){
+    math::Matrix<> matrix{
+            {3, 0},
+            {0, -4}
+    };
+    std::ostringstream out;
+    out << utils::Summary(matrix);
+    ASSERT_EQ(out.str(), "2x2 frobenius=5 max=4");
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include <math/matrix.hpp>
+#include <math/vector.hpp>
+#include <utility>
+
+TEST(MatrixTests, CompoundOperators){
+    math::Matrix<> matrix{{1, 2}, {3, 4}};
+    math::Matrix<> other{{4, 3}, {2, 1}};
+    auto data = matrix.Data();
+    matrix += other;
+    ASSERT_EQ(matrix, (math::Matrix<>{{5, 5}, {5, 5}}));
+    matrix -= other;
+    matrix *= 2;
+    matrix /= 4;
+    ASSERT_EQ(matrix, (math::Matrix<>{{0.5, 1}, {1.5, 2}}));
+    ASSERT_EQ(matrix.Data(), data);
+    ASSERT_THROW(matrix += math::Matrix<>(3), std::invalid_argument);
+}
+
+TEST(MatrixTests, RvalueOperandsKeepBuffer){
+    math::Matrix<> matrix{{1, 2}, {3, 4}};
+    auto temporary = matrix;
+    auto data = temporary.Data();
+    auto sum = std::move(temporary) + matrix;
+    ASSERT_EQ(sum.Data(), data);
+    auto difference = matrix - std::move(sum);
+    ASSERT_EQ(difference.Data(), data);
+    ASSERT_EQ(difference, matrix * -1);
+    auto scaled = -2 * (std::move(difference) / 2);
+    ASSERT_EQ(scaled.Data(), data);
+    ASSERT_EQ(scaled, matrix);
+}
+
+TEST(MatrixTests, Assignment){
+    math::Matrix<> matrix{{1, 2}, {3, 4}};
+    math::Matrix<> target(2);
+    auto data = target.Data();
+    target = matrix;
+    ASSERT_EQ(target, matrix);
+    ASSERT_EQ(target.Data(), data);
+    math::Matrix<float> narrow(2);
+    ASSERT_EQ(&(narrow = matrix), &narrow);
+    ASSERT_EQ(narrow[1][0], 3);
+    math::Matrix<float> resized(3);
+    resized = matrix;
+    ASSERT_EQ(resized.nRows(), 2);
+    ASSERT_EQ(resized[1][1], 4);
+    math::Matrix<> reshaped(3, 1);
+    reshaped = matrix;
+    ASSERT_EQ(reshaped, matrix);
+    auto moved = std::move(target);
+    ASSERT_EQ(moved.Data(), data);
+    ASSERT_EQ(target.nRows(), 0);
+}
+
+TEST(MatrixTests, VectorOperators){
+    math::Vector<> vector{3, 4};
+    auto normalized = math::Normalized(math::Vector<>{3, 4});
+    ASSERT_EQ(normalized, (math::Vector<>{0.6, 0.8}));
+    auto data = normalized.Data();
+    auto difference = vector - std::move(normalized);
+    ASSERT_EQ(difference.Data(), data);
+    difference *= -1;
+    difference += vector;
+    ASSERT_NEAR(difference[0], 0.6, 1e-15);
+    ASSERT_NEAR(difference[1], 0.8, 1e-15);
+    ASSERT_EQ((std::move(difference) * 5).Data(), data);
+}
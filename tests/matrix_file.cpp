@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <math/solver.hpp>
+#include <utils/matrix_file.hpp>
+#include <utils/generator.hpp>
+#include <fstream>
+#include <string>
+#include "temp_file.hpp"
+
+namespace {
+    class MatrixFileTests : public TempFileTest {};
+
+    math::Matrix<> MakeMatrix(size_t rows, size_t columns){
+        math::Matrix<> matrix(rows, columns);
+        for (size_t i = 0; i < rows; i++)
+            for (size_t j = 0; j < columns; j++)
+                matrix[i][j] = static_cast<double>(i) * 1000 + static_cast<double>(j) + 0.25;
+        return matrix;
+    }
+}
+
+TEST_F(MatrixFileTests, DenseRoundTrip){
+    auto matrix = MakeMatrix(13, 21);
+    utils::WriteMatrix(path_, matrix);
+    {
+        utils::MappedMatrixFile<> file(path_);
+        ASSERT_EQ(file.nRows(), 13);
+        ASSERT_EQ(file.nColumns(), 21);
+        ASSERT_FALSE(file.Header().IsSymmetric());
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(file.Data()) % 64, 0);
+        auto view = file.View();
+        for (size_t i = 0; i < 13; i++)
+            for (size_t j = 0; j < 21; j++)
+                ASSERT_EQ(view(i, j), matrix[i][j]);
+    }
+    ASSERT_EQ(utils::LoadMatrix(path_), matrix);
+    ASSERT_THROW(utils::MappedMatrixFile<float>{path_}, std::invalid_argument);
+}
+
+TEST_F(MatrixFileTests, StreamingAndSymmetric){
+    math::Matrix<> matrix(9);
+    for (size_t i = 0; i < 9; i++)
+        for (size_t j = i; j < 9; j++)
+            matrix[i][j] = matrix[j][i] = static_cast<double>(i + 2 * j);
+    {
+        utils::MatrixFileWriter<> writer(path_, 9, 9, true);
+        for (size_t i = 0; i < 9; i++)
+            writer.WriteRow(matrix.Row(i));
+        writer.Close();
+    }
+    ASSERT_EQ(utils::LoadMatrix(path_), matrix);
+    auto packed = utils::LoadSymmetricMatrix(path_);
+    ASSERT_EQ(math::Matrix<>(packed), matrix);
+    utils::WriteMatrix(path_, packed);
+    ASSERT_EQ(utils::LoadMatrix(path_), matrix);
+
+    utils::MatrixFileWriter<> incomplete(path_, 9, 9);
+    incomplete.WriteRow(matrix.Row(0));
+    ASSERT_THROW(incomplete.Close(), std::runtime_error);
+}
+
+TEST_F(MatrixFileTests, RejectsForeignFiles){
+    {
+        std::ofstream out(path_);
+        out << std::string(100, 'x');
+    }
+    ASSERT_THROW(utils::MappedMatrixFile<>{path_}, std::invalid_argument);
+}
+
+TEST_F(MatrixFileTests, RejectsBadHeaders){
+    auto patched = [&](auto change){
+        utils::WriteMatrix(path_, MakeMatrix(3, 4));
+        utils::MatrixFileHeader header{};
+        {
+            std::ifstream in(path_, std::ios::binary);
+            in.read(reinterpret_cast<char*>(&header), sizeof(header));
+        }
+        change(header);
+        std::fstream out(path_, std::ios::binary | std::ios::in | std::ios::out);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    };
+    patched([](utils::MatrixFileHeader& header){ header.byte_order = __builtin_bswap32(header.byte_order); });
+    ASSERT_THROW(utils::MappedMatrixFile<>{path_}, std::invalid_argument);
+    //2^33 * 2^31 cells wrap around to 0 in 64 bits
+    patched([](utils::MatrixFileHeader& header){
+        header.rows = uint64_t{1} << 33;
+        header.columns = uint64_t{1} << 31;
+    });
+    ASSERT_THROW(utils::MappedMatrixFile<>{path_}, std::invalid_argument);
+    patched([](utils::MatrixFileHeader& header){
+        header.flags = utils::kMatrixFileSymmetric;
+        header.rows = header.columns = UINT64_MAX;
+    });
+    ASSERT_THROW(utils::MappedMatrixFile<>{path_}, std::invalid_argument);
+    patched([](utils::MatrixFileHeader&){});
+    ASSERT_EQ(utils::LoadMatrix(path_), MakeMatrix(3, 4));
+}
+
+TEST_F(MatrixFileTests, SavesGeneratorMatrix){
+    constexpr utils::Traits<double> traits{
+            .kMin = -10,
+            .kMax = 10,
+            .kSize = 4
+    };
+    utils::Generator<double, traits> generator;
+    generator.GenerateAll();
+    const auto& [vector, house_m, diag_m, result_m] = generator.GetAll();
+    utils::WriteMatrix(path_, result_m);
+    ASSERT_EQ(utils::LoadMatrix(path_), math::Matrix<>(result_m));
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include <math/solver.hpp>
+#include <utils/out_of_core_matrix.hpp>
+#include "temp_file.hpp"
+
+namespace {
+    class OutOfCoreMatrixTests : public TempFileTest {};
+}
+
+TEST_F(OutOfCoreMatrixTests, StreamsPanels){
+    math::Matrix<> matrix(37, 23);
+    for (size_t i = 0; i < 37; i++)
+        for (size_t j = 0; j < 23; j++)
+            matrix[i][j] = std::sin(static_cast<double>(i * 23 + j));
+    utils::WriteMatrix(path_, matrix);
+    math::Vector<> x(23);
+    for (size_t j = 0; j < 23; j++) x[j] = 1.0 / (j + 1);
+    math::Vector<> expected(37);
+    auto expected_dot = math::GemvDot(matrix, x, expected);
+    for (size_t panel_bytes : {size_t{1}, 5 * 23 * sizeof(double), size_t{1} << 20}){
+        utils::OutOfCoreMatrix<> streamed(path_, panel_bytes);
+        math::Vector<> y(37);
+        for (size_t pass = 0; pass < 3; pass++){
+            auto dot = GemvDot(streamed, x, y);
+            ASSERT_NEAR(dot, expected_dot, 1e-12);
+            for (size_t i = 0; i < 37; i++)
+                ASSERT_NEAR(y[i], expected[i], 1e-12);
+        }
+    }
+}
+
+TEST_F(OutOfCoreMatrixTests, SolverOperator){
+    math::Matrix<> matrix(40);
+    for (size_t i = 0; i < 40; i++){
+        matrix[i][i] = 1 + 0.5 * static_cast<double>(i);
+        if (i > 0) matrix[i][i - 1] = matrix[i - 1][i] = 0.1;
+    }
+    utils::WriteMatrix(path_, matrix);
+    constexpr math::Traits<double> traits{
+            .kMin = -1,
+            .kMax = 1,
+            .kEpsEigenVector = 1e-12,
+            .kEpsEigenLambda = 1e-14,
+            .kMaxCountIterations = 100000
+    };
+    using Distribution = std::uniform_real_distribution<>;
+    math::Solver<double, traits, math::RandomSeed::No, Distribution, utils::OutOfCoreMatrix<>> streamed_solver(
+            40, utils::OutOfCoreMatrix<>(path_, 7 * 40 * sizeof(double)), std::vector<math::EigenPair<>>{});
+    math::Solver<double, traits, math::RandomSeed::No, Distribution> dense_solver(
+            40, matrix, std::vector<math::EigenPair<>>{});
+    streamed_solver.Solve();
+    dense_solver.Solve();
+    ASSERT_NEAR(std::get<1>(streamed_solver.GetAll()), std::get<1>(dense_solver.GetAll()), 1e-12);
+}
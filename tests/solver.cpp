@@ -0,0 +1,274 @@
+#include <gtest/gtest.h>
+#include <math/solver.hpp>
+#include "allocation_counter.hpp"
+
+namespace {
+    constexpr math::Traits<double> kTraits{
+            .kMin = -10,
+            .kMax = 10,
+            .kEpsEigenVector = 1e-14,
+            .kEpsEigenLambda = 1e-14,
+            .kMaxCountIterations = 1000
+    };
+    using TestSolver = math::Solver<double, kTraits, math::RandomSeed::No, std::uniform_real_distribution<>>;
+
+    math::Matrix<> MakeDiagonal(std::initializer_list<double> values){
+        math::Matrix<> matrix(values.size());
+        size_t i = 0;
+        for (auto value : values){
+            matrix[i][i] = value;
+            i++;
+        }
+        return matrix;
+    }
+
+    math::Matrix<> MakeDiagonal(size_t size){
+        math::Matrix<> matrix(size);
+        for (size_t i = 0; i < size; i++){
+            matrix[i][i] = double(i + 1) / size;
+        }
+        return matrix;
+    }
+}
+
+TEST(SolverTests, FindsSecondEigenvalue){
+    TestSolver solver(3, MakeDiagonal({5, -3, 1}), 5, math::Vector<>{1, 0, 0});
+    solver.Solve();
+    const auto& [previous_lambda, lambda, x, previous_x, count_iteration] = solver.GetAll();
+    ASSERT_NEAR(lambda, -3, 1e-10);
+}
+
+TEST(SolverTests, SolveDoesNotAllocate){
+    TestSolver solver(64, MakeDiagonal(64), 0, math::Vector<>(64));
+    auto before = AllocationsCount();
+    solver.Solve();
+    ASSERT_EQ(AllocationsCount(), before);
+}
+
+TEST(SolverTests, DeflatesSeveralPairs){
+    TestSolver solver(4, MakeDiagonal({7, -5, 3, 1}), {
+            {7, math::Vector<>{1, 0, 0, 0}},
+            {-5, math::Vector<>{0, 1, 0, 0}}
+    });
+    solver.Solve();
+    const auto& [previous_lambda, lambda, x, previous_x, count_iteration] = solver.GetAll();
+    ASSERT_NEAR(lambda, 3, 1e-10);
+}
+
+namespace {
+    template<math::Acceleration kAcceleration, int kShift>
+    auto SolveWith(size_t size){
+        constexpr math::Traits<double> traits{
+                .kMin = -10,
+                .kMax = 10,
+                .kEpsEigenVector = 1e-12,
+                .kEpsEigenLambda = 1e-13,
+                .kMaxCountIterations = 10000,
+                .kAcceleration = kAcceleration,
+                .kShift = kShift
+        };
+        math::Matrix<> matrix(size);
+        for (size_t i = 0; i < size; i++){
+            matrix[i][i] = 10 - 0.01 * i;
+            if (i > 0) matrix[i][i - 1] = matrix[i - 1][i] = 0.001;
+        }
+        math::Solver<double, traits, math::RandomSeed::No, std::uniform_real_distribution<>> solver(
+                size, matrix, std::vector<math::EigenPair<>>{});
+        solver.Solve();
+        auto [previous_lambda, lambda, x, previous_x, count_iteration] = solver.GetAll();
+        auto image = matrix * math::Normalized(x);
+        double residual = 0;
+        for (size_t i = 0; i < size; i++){
+            residual = std::max(residual, std::abs(image[i] - lambda * math::Normalized(x)[i]));
+        }
+        return std::make_tuple(lambda, count_iteration, residual);
+    }
+}
+
+TEST(SolverTests, AccelerationModes){
+    auto [plain_lambda, plain_count, plain_residual] = SolveWith<math::Acceleration::None, 0>(20);
+    auto [aitken_lambda, aitken_count, aitken_residual] = SolveWith<math::Acceleration::Aitken, 0>(20);
+    auto [shift_lambda, shift_count, shift_residual] = SolveWith<math::Acceleration::Shift, 9>(20);
+    auto [invert_lambda, invert_count, invert_residual] = SolveWith<math::Acceleration::ShiftInvert, 11>(20);
+    auto [rayleigh_lambda, rayleigh_count, rayleigh_residual] = SolveWith<math::Acceleration::RayleighQuotient, 11>(20);
+    ASSERT_NEAR(aitken_lambda, plain_lambda, 1e-9);
+    ASSERT_NEAR(shift_lambda, plain_lambda, 1e-9);
+    ASSERT_NEAR(invert_lambda, plain_lambda, 1e-9);
+    //rayleigh quotient iteration converges to some eigenpair, not necessarily the dominant one
+    ASSERT_LE(rayleigh_lambda, plain_lambda + 1e-9);
+    ASSERT_LT(shift_count, plain_count);
+    ASSERT_LT(invert_count, plain_count);
+    ASSERT_LT(rayleigh_count, invert_count);
+    ASSERT_LT(invert_residual, 1e-6);
+    ASSERT_LT(rayleigh_residual, 1e-9);
+}
+
+TEST(SolverTests, MixedPrecision){
+    constexpr math::Traits<double> full_traits{
+            .kMin = -1,
+            .kMax = 1,
+            .kEpsEigenVector = 1e-12,
+            .kEpsEigenLambda = 1e-14,
+            .kMaxCountIterations = 100000
+    };
+    constexpr math::Traits<double> mixed_traits{
+            .kMin = -1,
+            .kMax = 1,
+            .kEpsEigenVector = 1e-12,
+            .kEpsEigenLambda = 1e-14,
+            .kMaxCountIterations = 100000,
+            .kPrecision = math::Precision::Mixed
+    };
+    auto matrix = MakeDiagonal({9, -6, 4, 2, 1});
+    for (size_t i = 0; i + 1 < 5; i++) matrix[i][i + 1] = matrix[i + 1][i] = 0.5;
+    using Distribution = std::uniform_real_distribution<>;
+    math::Solver<double, full_traits, math::RandomSeed::No, Distribution> full(5, matrix, std::vector<math::EigenPair<>>{});
+    math::Solver<double, mixed_traits, math::RandomSeed::No, Distribution> mixed(5, matrix, std::vector<math::EigenPair<>>{});
+    full.Solve();
+    mixed.Solve();
+    ASSERT_NEAR(std::get<1>(mixed.GetAll()), std::get<1>(full.GetAll()), 1e-12);
+    auto mixed_x = math::Normalized(std::get<2>(mixed.GetAll()));
+    auto full_x = math::Normalized(std::get<2>(full.GetAll()));
+    ASSERT_NEAR(std::abs(math::Dot(mixed_x, full_x)), 1, 1e-12);
+}
+
+//the float phase stops early enough to leave iterations to the double one, within kMaxCountIterations
+TEST(SolverTests, MixedPrecisionKeepsRefinement){
+    constexpr math::Traits<double> traits{
+            .kMin = -1,
+            .kMax = 1,
+            .kEpsEigenVector = 1e-12,
+            .kEpsEigenLambda = 1e-14,
+            .kMaxCountIterations = 8,
+            .kPrecision = math::Precision::Mixed
+    };
+    math::Solver<double, traits, math::RandomSeed::No, std::uniform_real_distribution<>> solver(
+            4, MakeDiagonal({9, 8.9, 8.8, 1}), std::vector<math::EigenPair<>>{});
+    solver.Solve();
+    ASSERT_EQ(std::get<4>(solver.GetAll()), 8);
+}
+
+TEST(SolverTests, FloatNumber){
+    constexpr math::Traits<float> traits{
+            .kMin = -1,
+            .kMax = 1,
+            .kEpsEigenVector = 1e-5,
+            .kEpsEigenLambda = 1e-6,
+            .kMaxCountIterations = 100000
+    };
+    math::Matrix<float> matrix(3);
+    matrix[0][0] = 5;
+    matrix[1][1] = -2;
+    matrix[2][2] = 1;
+    math::Solver<float, traits, math::RandomSeed::No, std::uniform_real_distribution<float>> solver(
+            3, matrix, std::vector<math::EigenPair<float>>{});
+    solver.Solve();
+    const auto& [previous_lambda, lambda, x, previous_x, count_iteration] = solver.GetAll();
+    static_assert(std::is_same_v<std::remove_cvref_t<decltype(lambda)>, float>);
+    ASSERT_NEAR(lambda, 5, 1e-4);
+}
+
+TEST(SolverTests, RecordsIterations){
+    constexpr math::Traits<double> traits{
+            .kMin = -1,
+            .kMax = 1,
+            .kEpsEigenVector = 1e-12,
+            .kEpsEigenLambda = 1e-14,
+            .kMaxCountIterations = 100000
+    };
+    using RecordedSolver = math::Solver<double, traits, math::RandomSeed::No, std::uniform_real_distribution<>,
+            math::Matrix<>, math::ConvergenceRecorder>;
+    RecordedSolver solver(3, MakeDiagonal({5, -3, 1}), std::vector<math::EigenPair<>>{});
+    auto before = AllocationsCount();
+    solver.Solve();
+    ASSERT_EQ(AllocationsCount(), before);
+    const auto& [previous_lambda, lambda, x, previous_x, count_iteration] = solver.GetAll();
+    auto& recorder = solver.GetObserver();
+    ASSERT_EQ(recorder.Count(), count_iteration);
+    auto records = recorder.Records();
+    ASSERT_EQ(records.size(), std::min(count_iteration, recorder.Capacity()));
+    ASSERT_EQ(records.back().iteration, count_iteration);
+    ASSERT_EQ(records.back().lambda, lambda);
+    ASSERT_LT(records.back().residual, records.front().residual);
+    ASSERT_LT(records.back().residual, 1e-6);
+    ASSERT_GE(records.back().seconds, 0);
+    ASSERT_FALSE(solver.Stopped());
+}
+
+TEST(SolverTests, ObserverStopsEarly){
+    constexpr math::Traits<double> traits{
+            .kMin = -1,
+            .kMax = 1,
+            .kEpsEigenVector = 1e-12,
+            .kEpsEigenLambda = 1e-14,
+            .kMaxCountIterations = 100000
+    };
+    struct StopAfterFive{
+        math::ObserverAction operator()(const math::IterationRecord& record) const{
+            return record.iteration >= 5 ? math::ObserverAction::Stop : math::ObserverAction::Continue;
+        }
+    };
+    math::Solver<double, traits, math::RandomSeed::No, std::uniform_real_distribution<>,
+            math::Matrix<>, StopAfterFive> solver(3, MakeDiagonal({5, -3, 1}), std::vector<math::EigenPair<>>{});
+    solver.Solve();
+    ASSERT_EQ(std::get<4>(solver.GetAll()), 5);
+    ASSERT_TRUE(solver.Stopped());
+
+    math::Solver<double, traits, math::RandomSeed::No, std::uniform_real_distribution<>,
+            math::Matrix<>, math::ConvergenceRecorder> requested(3, MakeDiagonal({5, -3, 1}), std::vector<math::EigenPair<>>{});
+    requested.GetObserver().RequestStop();
+    requested.Solve();
+    ASSERT_EQ(std::get<4>(requested.GetAll()), 1);
+}
+
+TEST(SolverTests, CheckInterval){
+    constexpr math::Traits<double> every_traits{
+            .kMin = -1,
+            .kMax = 1,
+            .kEpsEigenVector = 1e-12,
+            .kEpsEigenLambda = 1e-14,
+            .kMaxCountIterations = 100000
+    };
+    constexpr math::Traits<double> sparse_traits{
+            .kMin = -1,
+            .kMax = 1,
+            .kEpsEigenVector = 1e-12,
+            .kEpsEigenLambda = 1e-14,
+            .kMaxCountIterations = 100000,
+            .kCheckInterval = 8
+    };
+    using Distribution = std::uniform_real_distribution<>;
+    math::Solver<double, every_traits, math::RandomSeed::No, Distribution> every(
+            5, MakeDiagonal({9, -6, 4, 2, 1}), std::vector<math::EigenPair<>>{});
+    math::Solver<double, sparse_traits, math::RandomSeed::No, Distribution> sparse(
+            5, MakeDiagonal({9, -6, 4, 2, 1}), std::vector<math::EigenPair<>>{});
+    every.Solve();
+    sparse.Solve();
+    auto every_count = std::get<4>(every.GetAll());
+    auto sparse_count = std::get<4>(sparse.GetAll());
+    ASSERT_EQ(sparse_count % 8, 0);
+    ASSERT_GE(sparse_count, every_count);
+    ASSERT_LT(sparse_count, every_count + 8);
+    ASSERT_NEAR(std::get<1>(sparse.GetAll()), 9, 1e-12);
+}
+
+TEST(SolverTests, ResidualCriterion){
+    constexpr math::Traits<double> traits{
+            .kMin = -1,
+            .kMax = 1,
+            .kEpsEigenVector = 1e-9,
+            .kEpsEigenLambda = -1,
+            .kMaxCountIterations = 100000,
+            .kCriterion = math::Criterion::Residual
+    };
+    auto matrix = MakeDiagonal({9, -6, 4, 2, 1});
+    for (size_t i = 0; i + 1 < 5; i++) matrix[i][i + 1] = matrix[i + 1][i] = 0.5;
+    math::Solver<double, traits, math::RandomSeed::No, std::uniform_real_distribution<>> solver(
+            5, matrix, std::vector<math::EigenPair<>>{});
+    solver.Solve();
+    const auto& [previous_lambda, lambda, x, previous_x, count_iteration] = solver.GetAll();
+    ASSERT_LT(count_iteration, traits.kMaxCountIterations);
+    auto v = math::Normalized(previous_x);
+    auto residual = matrix * v - lambda * v;
+    ASSERT_LE(std::sqrt(math::Dot(residual, residual)), 1e-9);
+}
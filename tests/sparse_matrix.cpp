@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include <math/solver.hpp>
+#include <math/sparse_matrix.hpp>
+
+namespace {
+    //graph Laplacian of a path: 2 on the diagonal (1 at the ends), -1 next to it
+    math::CsrMatrix<> MakePathLaplacian(size_t size){
+        std::vector<math::Triplet<>> entries;
+        for (size_t i = 0; i + 1 < size; i++){
+            entries.push_back({i, i + 1, -1});
+            entries.push_back({i + 1, i, -1});
+            entries.push_back({i, i, 1});
+            entries.push_back({i + 1, i + 1, 1});
+        }
+        return math::CsrMatrix<>(size, size, std::move(entries));
+    }
+}
+
+TEST(SparseMatrixTests, Construction){
+    math::CsrMatrix<> matrix(3, 4, {{2, 1, 5}, {0, 3, 1}, {0, 0, 2}, {2, 1, -1}});
+    ASSERT_EQ(matrix.NonZeros(), 3);
+    math::Matrix<> expected{
+            {2, 0, 0, 1},
+            {0, 0, 0, 0},
+            {0, 4, 0, 0}
+    };
+    ASSERT_EQ(math::Matrix<>(matrix), expected);
+    ASSERT_EQ(math::Matrix<>(math::CsrMatrix<>(expected)), expected);
+    ASSERT_THROW(math::CsrMatrix<>(2, 2, {{2, 0, 1}}), std::invalid_argument);
+}
+
+TEST(SparseMatrixTests, Spmv){
+    constexpr size_t kSize = 200000;
+    auto laplacian = MakePathLaplacian(kSize);
+    ASSERT_EQ(laplacian.NonZeros(), 3 * kSize - 2);
+    math::Vector<> x(kSize), y(kSize);
+    for (size_t i = 0; i < kSize; i++) x[i] = static_cast<double>(i % 3);
+    auto dot = math::GemvDot(laplacian, x, y);
+    double expected_dot = 0;
+    for (size_t i = 0; i < kSize; i++){
+        double expected = 0;
+        if (i > 0) expected += x[i] - x[i - 1];
+        if (i + 1 < kSize) expected += x[i] - x[i + 1];
+        ASSERT_DOUBLE_EQ(y[i], expected);
+        expected_dot += x[i] * expected;
+    }
+    ASSERT_NEAR(dot, expected_dot, 1e-6);
+}
+
+TEST(SparseMatrixTests, SolverOperator){
+    std::vector<math::Triplet<>> entries;
+    for (size_t i = 0; i < 50; i++) entries.push_back({i, i, 1 + 0.1 * static_cast<double>(i)});
+    entries.push_back({0, 49, 0.01});
+    entries.push_back({49, 0, 0.01});
+    math::CsrMatrix<> sparse(50, 50, entries);
+    constexpr math::Traits<double> traits{
+            .kMin = -1,
+            .kMax = 1,
+            .kEpsEigenVector = 1e-12,
+            .kEpsEigenLambda = 1e-14,
+            .kMaxCountIterations = 100000
+    };
+    using Distribution = std::uniform_real_distribution<>;
+    math::Solver<double, traits, math::RandomSeed::No, Distribution, math::CsrMatrix<>> sparse_solver(
+            50, sparse, std::vector<math::EigenPair<>>{});
+    math::Solver<double, traits, math::RandomSeed::No, Distribution> dense_solver(
+            50, math::Matrix<>(sparse), std::vector<math::EigenPair<>>{});
+    sparse_solver.Solve();
+    dense_solver.Solve();
+    ASSERT_NEAR(std::get<1>(sparse_solver.GetAll()), std::get<1>(dense_solver.GetAll()), 1e-12);
+}
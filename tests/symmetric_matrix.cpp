@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <math/solver.hpp>
+#include <math/symmetric_matrix.hpp>
+#include <utils/generator.hpp>
+
+namespace {
+    math::Matrix<> MakeSymmetric(size_t size){
+        math::Matrix<> matrix(size);
+        for (size_t i = 0; i < size; i++)
+            for (size_t j = i; j < size; j++)
+                matrix[i][j] = matrix[j][i] = static_cast<double>((i * 7 + j * 3) % 11) - 5;
+        return matrix;
+    }
+}
+
+TEST(SymmetricMatrixTests, PackedStorage){
+    auto dense = MakeSymmetric(37);
+    math::SymmetricMatrix<> packed(dense);
+    for (size_t i = 0; i < 37; i++)
+        for (size_t j = 0; j < 37; j++)
+            ASSERT_EQ(packed(i, j), dense[i][j]);
+    ASSERT_EQ(math::Matrix<>(packed), dense);
+}
+
+TEST(SymmetricMatrixTests, Symv){
+    auto dense = MakeSymmetric(53);
+    math::SymmetricMatrix<> packed(dense);
+    math::Vector<> x(53);
+    for (size_t i = 0; i < 53; i++) x[i] = 1.0 / (i + 1);
+    math::Vector<> expected(53), result(53);
+    auto expected_dot = math::GemvDot(dense, x, expected);
+    auto dot = math::GemvDot(packed, x, result);
+    ASSERT_NEAR(dot, expected_dot, 1e-10);
+    for (size_t i = 0; i < 53; i++)
+        ASSERT_NEAR(result[i], expected[i], 1e-12);
+}
+
+TEST(SymmetricMatrixTests, RankUpdates){
+    auto dense = MakeSymmetric(19);
+    math::SymmetricMatrix<> packed(dense);
+    math::Vector<> x(19);
+    for (size_t i = 0; i < 19; i++) x[i] = static_cast<double>(i) - 9;
+    packed.RankOneUpdate(-0.5, x);
+    for (size_t i = 0; i < 19; i++)
+        for (size_t j = 0; j < 19; j++)
+            ASSERT_NEAR(packed(i, j), dense[i][j] - 0.5 * x[i] * x[j], 1e-12);
+
+    math::Matrix<> block(19, 4);
+    for (size_t i = 0; i < 19; i++)
+        for (size_t j = 0; j < 4; j++)
+            block[i][j] = static_cast<double>((i + 2 * j) % 5) - 2;
+    math::SymmetricMatrix<> gram(19);
+    gram.RankKUpdate(2, block.View(), 0);
+    auto expected = block * block.TransposedView();
+    for (size_t i = 0; i < 19; i++)
+        for (size_t j = 0; j < 19; j++)
+            ASSERT_NEAR(gram(i, j), 2 * expected[i][j], 1e-12);
+}
+
+TEST(SymmetricMatrixTests, SolverOperator){
+    constexpr utils::Traits<double> generator_traits{
+            .kMin = -10,
+            .kMax = 10,
+            .kSize = 30
+    };
+    utils::Generator<double, generator_traits> generator;
+    generator.GenerateAll();
+    const auto& [vector, house_m, diag_m, result_m] = generator.GetAll();
+    constexpr math::Traits<double> traits{
+            .kMin = -1,
+            .kMax = 1,
+            .kEpsEigenVector = 1e-10,
+            .kEpsEigenLambda = 1e-14,
+            .kMaxCountIterations = 100000
+    };
+    using Distribution = std::uniform_real_distribution<>;
+    math::Solver<double, traits, math::RandomSeed::No, Distribution> dense_solver(
+            generator_traits.kSize, result_m, std::vector<math::EigenPair<>>{});
+    math::Solver<double, traits, math::RandomSeed::No, Distribution, math::SymmetricMatrix<>> packed_solver(
+            generator_traits.kSize, math::SymmetricMatrix<>(result_m), std::vector<math::EigenPair<>>{});
+    dense_solver.Solve();
+    packed_solver.Solve();
+    ASSERT_NEAR(std::get<1>(packed_solver.GetAll()), std::get<1>(dense_solver.GetAll()), 1e-9);
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <string>
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+//a file per test and process, so parallel runs do not share it; removed after the test
+class TempFileTest : public ::testing::Test {
+protected:
+    std::string path_;
+
+    static int ProcessId() {
+#ifdef _WIN32
+        return _getpid();
+#else
+        return static_cast<int>(getpid());
+#endif
+    }
+
+    void SetUp() override {
+        auto name = std::string("numeric_methods_") +
+                    ::testing::UnitTest::GetInstance()->current_test_info()->name() + "_" +
+                    std::to_string(ProcessId()) + ".nmm";
+        path_ = (std::filesystem::temp_directory_path() / name).string();
+    }
+
+    void TearDown() override {
+        std::filesystem::remove(path_);
+    }
+};
@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include <utils/thread_pool.hpp>
+#include <math/vector.hpp>
+#include <numeric>
+#include <random>
+
+TEST(ThreadPoolTests, ParallelForCoversRange){
+    utils::ThreadPool pool(4);
+    std::vector<int> marks(10007);
+    pool.ParallelFor(0, marks.size(), 13, [&](size_t begin, size_t end){
+        for (size_t i = begin; i < end; i++) marks[i]++;
+    });
+    ASSERT_EQ(std::count(marks.begin(), marks.end(), 1), marks.size());
+}
+
+TEST(ThreadPoolTests, NestedAndExceptions){
+    utils::ThreadPool pool(3);
+    std::atomic<size_t> sum{0};
+    pool.ParallelFor(0, 8, 1, [&](size_t, size_t){
+        pool.ParallelFor(0, 100, 10, [&](size_t inner_begin, size_t inner_end){
+            sum += inner_end - inner_begin;
+        });
+    });
+    ASSERT_EQ(sum, 800);
+    ASSERT_THROW(pool.ParallelFor(0, 10, 1, [](size_t begin, size_t){
+        if (begin == 7) throw std::runtime_error("task");
+    }), std::runtime_error);
+}
+
+TEST(ThreadPoolTests, ParallelKernelsMatchSequential){
+    std::mt19937 generator{2};
+    std::uniform_real_distribution<> distribution{-1, 1};
+    math::Matrix<> left(300, 250), right(250, 270);
+    math::Vector<> vector(250);
+    for (size_t i = 0; i < 300; i++) for (size_t j = 0; j < 250; j++) left[i][j] = distribution(generator);
+    for (size_t i = 0; i < 250; i++) for (size_t j = 0; j < 270; j++) right[i][j] = distribution(generator);
+    for (auto& elem : vector) elem = distribution(generator);
+
+    utils::ThreadPool::SetSharedThreadsCount(1);
+    auto product = left * right;
+    auto sum = left + left;
+    auto transposed = left.Transposition();
+    auto image = left * vector;
+    utils::ThreadPool::SetSharedThreadsCount(4);
+    ASSERT_TRUE(left * right == product);
+    ASSERT_TRUE(left + left == sum);
+    ASSERT_TRUE(left.Transposition() == transposed);
+    ASSERT_TRUE(left * vector == image);
+    utils::ThreadPool::SetSharedThreadsCount(std::thread::hardware_concurrency());
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include <math/expression.hpp>
+#include <random>
+
+namespace {
+    math::Matrix<> RandomMatrix(size_t rows, size_t columns){
+        std::mt19937 generator{rows * 1000 + columns};
+        std::uniform_real_distribution<> distribution{-1, 1};
+        math::Matrix<> matrix(rows, columns);
+        for (size_t i = 0; i < rows; i++)
+            for (size_t j = 0; j < columns; j++)
+                matrix[i][j] = distribution(generator);
+        return matrix;
+    }
+
+    void ExpectNear(const math::Matrix<>& result, const math::Matrix<>& expected){
+        ASSERT_EQ(result.nRows(), expected.nRows());
+        ASSERT_EQ(result.nColumns(), expected.nColumns());
+        for (size_t i = 0; i < result.nRows(); i++)
+            for (size_t j = 0; j < result.nColumns(); j++)
+                ASSERT_NEAR(result[i][j], expected[i][j], 1e-12);
+    }
+}
+
+TEST(ViewTests, ProductsWithTransposedViews){
+    auto left = RandomMatrix(37, 300);
+    auto right = RandomMatrix(45, 300);
+    ExpectNear(left * right.TransposedView(), left * right.Transposition());
+    ExpectNear(left.TransposedView() * left, left.Transposition() * left);
+    auto small = RandomMatrix(20, 37);
+    ExpectNear(left.TransposedView() * small.TransposedView(), left.Transposition() * small.Transposition());
+}
+
+TEST(ViewTests, RowsColumnsAndBlocks){
+    math::Matrix<> matrix{
+            {1, 2, 3},
+            {4, 5, 6},
+            {7, 8, 9}
+    };
+    auto column = matrix.Column(1);
+    ASSERT_EQ(column.size(), 3);
+    ASSERT_EQ(column[2], 8);
+    ASSERT_TRUE(math::Vector<>(column) == (math::Vector<>{2, 5, 8}));
+    ASSERT_EQ(math::Dot(matrix.Row(0), column), 1 * 2 + 2 * 5 + 3 * 8);
+
+    auto block = matrix.Block(1, 1, 2, 2);
+    math::Matrix<> expected_block{{5, 6}, {8, 9}};
+    ASSERT_TRUE(math::Matrix<>(block) == expected_block);
+    ASSERT_TRUE(math::Matrix<>(block.Transposed()) == expected_block.Transposition());
+    math::Matrix<> square = block * block;
+    ASSERT_TRUE(square == expected_block * expected_block);
+    math::Matrix<> outer = math::Outer(matrix.Column(0), matrix.Row(2));
+    ASSERT_EQ(outer[2][1], 7 * 8);
+}
+
+TEST(ViewTests, GemvOverViews){
+    auto matrix = RandomMatrix(20, 30);
+    math::Vector<> x(20), y(30), expected(30);
+    for (size_t i = 0; i < x.size(); i++) x[i] = i + 1.0;
+    math::GemvDot(matrix.TransposedView(), x.View(), y.View());
+    auto transposed = matrix.Transposition();
+    math::GemvDot(transposed, x, expected);
+    for (size_t i = 0; i < y.size(); i++)
+        ASSERT_NEAR(y[i], expected[i], 1e-12);
+}